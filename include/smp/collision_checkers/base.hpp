@@ -46,6 +46,10 @@ namespace collision_checkers {
 */
 template <class State> class Base {
 
+  // The two states of a step, for the default check_collision_step(). The
+  // list is kept so that checking a step does not allocate.
+  std::list<State *> step_states = std::list<State *>(2);
+
 public:
   virtual ~Base(){};
   /**
@@ -69,6 +73,30 @@ public:
    *         if error.
    */
   virtual int check_collision(const std::list<State *> &list_states) = 0;
+
+  /**
+   * \brief Checks whether a step of a trajectory is collision free
+   *
+   * The step goes from state_prev_in, which is already known to be collision
+   * free, to state_curr_in. Extenders call this function for every step as
+   * they generate a trajectory, so that they can stop at the first
+   * collision. The default implementation checks the two states as a
+   * trajectory; collision checkers should override it to check the step
+   * directly. Those that check trajectories state by state only need to
+   * check state_curr_in.
+   *
+   * @param state_prev_in The state that the step starts from.
+   * @param state_curr_in The state that the step reaches.
+   *
+   * @return Returns 1 if the step is collision-free, 0 if the step collides
+   *         with an obstacle, and a non-positive if error.
+   */
+  virtual int check_collision_step(State *state_prev_in,
+                                   State *state_curr_in) {
+    step_states.front() = state_prev_in;
+    step_states.back() = state_curr_in;
+    return check_collision(step_states);
+  }
 };
 } // namespace collision_checkers
 } // namespace smp
@@ -0,0 +1,290 @@
+/*! \file components/collision_checkers/cache.h
+  \brief A cache of collision checking results
+
+  This file implements a collision checker that remembers the results of
+  another collision checker for discretized states.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <smp/collision_checkers/base.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+namespace smp {
+namespace collision_checkers {
+
+//! Collision checker that caches the results of another collision checker.
+/*!
+  States are discretized to a grid cell, given by the first two state
+  variables and the resolution, and to a heading bin, given by the third state
+  variable. Bin m covers the headings within half a bin width of
+  m * 2 * pi / num_headings, like the slices of HeadingBitmaps, so that the
+  bins and the slices line up when both use the same number of headings.
+
+  The first check of a discretized state is forwarded to the wrapped
+  collision checker, and its result is reused for every later state in the
+  same cell and heading bin. The results are kept in an open-addressing hash
+  table with linear probing, which is cleared when it becomes half full.
+
+  A list of states is checked state by state through the cache, so the
+  wrapped checker should be one whose list check only checks the states of
+  the list, such as the multiple circles checkers.
+
+  When part of the map changes, invalidate() drops the results of the states
+  whose cell lies within the reach of the wrapped checker from the changed
+  region.
+
+  \ingroup collision_checkers
+*/
+template <class State> class Cache : public Base<State> {
+
+  static const uint64_t empty_key = ~(uint64_t)0;
+
+  // Number of bits of each field of a key.
+  static const int cell_bits = 24;
+  static const int heading_bits = 16;
+
+  // Number of heading bins when none is given.
+  static const int default_num_headings = 72;
+
+  Base<State> &collision_checker;
+
+  double resolution;
+  double origin_x;
+  double origin_y;
+  int num_headings;
+  double reach;
+
+  std::vector<uint64_t> keys;
+  std::vector<unsigned char> results;
+  size_t num_entries;
+
+  unsigned long num_hits;
+  unsigned long num_misses;
+
+  inline uint64_t make_key(int cell_x, int cell_y, int heading) const {
+    const uint64_t cell_mask = ((uint64_t)1 << cell_bits) - 1;
+    const int cell_offset = 1 << (cell_bits - 1);
+    return ((uint64_t)((cell_x + cell_offset) & cell_mask)
+            << (cell_bits + heading_bits)) |
+           ((uint64_t)((cell_y + cell_offset) & cell_mask) << heading_bits) |
+           (uint64_t)heading;
+  }
+
+  inline void decode_key(uint64_t key, int *cell_x, int *cell_y) const {
+    const uint64_t cell_mask = ((uint64_t)1 << cell_bits) - 1;
+    const int cell_offset = 1 << (cell_bits - 1);
+    *cell_x = (int)((key >> (cell_bits + heading_bits)) & cell_mask) -
+              cell_offset;
+    *cell_y = (int)((key >> heading_bits) & cell_mask) - cell_offset;
+  }
+
+  inline uint64_t key_of(State *state) const {
+    int cell_x = (int)floor((state->state_vars[0] - origin_x) / resolution);
+    int cell_y = (int)floor((state->state_vars[1] - origin_y) / resolution);
+    int heading =
+        (int)floor(state->state_vars[2] * num_headings / (2.0 * M_PI) + 0.5) %
+        num_headings;
+    if (heading < 0)
+      heading += num_headings;
+    return make_key(cell_x, cell_y, heading);
+  }
+
+  // Index of the slot that holds the key, or of the empty slot where it
+  // would be inserted.
+  inline size_t find_slot(uint64_t key) const {
+    const size_t mask = keys.size() - 1;
+    size_t slot = (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    while ((keys[slot] != empty_key) && (keys[slot] != key))
+      slot = (slot + 1) & mask;
+    return slot;
+  }
+
+public:
+  /**
+   * \brief Creates a cache in front of the given collision checker.
+   *
+   * @param collision_checker_in The wrapped collision checker.
+   * @param capacity Number of slots of the hash table, rounded up to a power
+   *                 of two. At most half of them are used.
+   */
+  Cache(Base<State> &collision_checker_in, size_t capacity = 1 << 16)
+      : collision_checker(collision_checker_in), resolution(0.05),
+        origin_x(0.0), origin_y(0.0), num_headings(default_num_headings),
+        reach(0.0),
+        num_entries(0), num_hits(0), num_misses(0) {
+
+    size_t size = 2;
+    while (size < capacity)
+      size *= 2;
+    keys.assign(size, empty_key);
+    results.assign(size, 0);
+  }
+
+  ~Cache() {}
+
+  int check_collision(State *state_in) {
+
+    uint64_t key = key_of(state_in);
+    size_t slot = find_slot(key);
+    if (keys[slot] == key) {
+      num_hits++;
+      return results[slot];
+    }
+
+    num_misses++;
+    int result = collision_checker.check_collision(state_in);
+    if (result < 0) // Errors are not cached.
+      return result;
+
+    if (2 * (num_entries + 1) > keys.size()) {
+      clear();
+      slot = find_slot(key);
+    }
+    keys[slot] = key;
+    results[slot] = (unsigned char)result;
+    num_entries++;
+
+    return result;
+  }
+
+  int check_collision(const std::list<State *> &list_states) {
+
+    for (const auto &iter : list_states) {
+      int result = check_collision(iter);
+      if (result <= 0)
+        return result;
+    }
+    return 1;
+  }
+
+  int check_collision_step(State * /*state_prev_in*/, State *state_curr_in) {
+    return check_collision(state_curr_in);
+  }
+
+  /**
+   * \brief Sets the discretization of the states.
+   *
+   * Clears the cache if the discretization changes.
+   *
+   * @param resolution_in Size of a cell in meters, usually the resolution of
+   *                      the map.
+   * @param origin_x_in World x coordinate of the corner of a cell.
+   * @param origin_y_in World y coordinate of the corner of a cell.
+   * @param num_headings_in Number of heading bins, usually the number of
+   *                        heading slices of the wrapped checker, or 0 for
+   *                        the default number.
+   */
+  void set_discretization(double resolution_in, double origin_x_in,
+                          double origin_y_in, int num_headings_in) {
+    if (num_headings_in <= 0)
+      num_headings_in = default_num_headings;
+    num_headings_in = std::min(num_headings_in, 1 << heading_bits);
+    if ((resolution_in == resolution) && (origin_x_in == origin_x) &&
+        (origin_y_in == origin_y) && (num_headings_in == num_headings))
+      return;
+
+    resolution = resolution_in;
+    origin_x = origin_x_in;
+    origin_y = origin_y_in;
+    num_headings = num_headings_in;
+    clear();
+  }
+
+  /**
+   * \brief Sets how far from a state the wrapped checker looks at the map.
+   */
+  inline void set_reach(double reach_in) { reach = reach_in; }
+
+  /**
+   * \brief Drops the results that may depend on a region of the map.
+   *
+   * Drops the results of the states whose cell intersects the rectangle
+   * [x_min, x_max] x [y_min, y_max] grown by the reach.
+   */
+  void invalidate(double x_min, double y_min, double x_max, double y_max) {
+
+    int cell_x_min = (int)floor((x_min - reach - origin_x) / resolution);
+    int cell_y_min = (int)floor((y_min - reach - origin_y) / resolution);
+    int cell_x_max = (int)floor((x_max + reach - origin_x) / resolution);
+    int cell_y_max = (int)floor((y_max + reach - origin_y) / resolution);
+
+    // Collect the surviving entries and insert them again, which keeps the
+    // probe sequences intact.
+    std::vector<uint64_t> kept_keys;
+    std::vector<unsigned char> kept_results;
+    for (size_t slot = 0; slot < keys.size(); slot++) {
+      if (keys[slot] == empty_key)
+        continue;
+      int cell_x, cell_y;
+      decode_key(keys[slot], &cell_x, &cell_y);
+      if ((cell_x >= cell_x_min) && (cell_x <= cell_x_max) &&
+          (cell_y >= cell_y_min) && (cell_y <= cell_y_max))
+        continue;
+      kept_keys.push_back(keys[slot]);
+      kept_results.push_back(results[slot]);
+    }
+
+    clear();
+    for (size_t i = 0; i < kept_keys.size(); i++) {
+      size_t slot = find_slot(kept_keys[i]);
+      keys[slot] = kept_keys[i];
+      results[slot] = kept_results[i];
+    }
+    num_entries = kept_keys.size();
+  }
+
+  /**
+   * \brief Drops all results.
+   */
+  void clear() {
+    std::fill(keys.begin(), keys.end(), empty_key);
+    num_entries = 0;
+  }
+
+  /**
+   * \brief Resets the hit and miss counters.
+   */
+  void reset_statistics() {
+    num_hits = 0;
+    num_misses = 0;
+  }
+
+  inline unsigned long get_num_hits() const { return num_hits; }
+  inline unsigned long get_num_misses() const { return num_misses; }
+  inline size_t get_num_entries() const { return num_entries; }
+  inline size_t get_capacity() const { return keys.size(); }
+
+  /**
+   * \brief Returns the fraction of the checks answered from the cache.
+   */
+  inline double get_hit_rate() const {
+    unsigned long num_checks = num_hits + num_misses;
+    return (num_checks == 0) ? 0.0 : (double)num_hits / num_checks;
+  }
+};
+
+template <class State> const uint64_t Cache<State>::empty_key;
+} // namespace collision_checkers
+} // namespace smp
@@ -0,0 +1,145 @@
+/*! \file components/collision_checkers/heading_bitmaps.h
+  \brief Configuration-space obstacle bitmaps for discretized headings
+
+  This file implements a precomputed configuration-space obstacle map for a
+  planar robot with a fixed footprint. The headings are discretized into a
+  number of slices, and each slice stores one bit per map cell that tells
+  whether the robot collides when its origin lies in that cell.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace smp {
+namespace collision_checkers {
+
+//! Per-heading configuration-space obstacle bitmaps.
+/*!
+  The footprint is modeled as a set of circles of radius equal to the
+  inflation radius, one centered on each footprint vertex and one on the
+  origin of the robot frame. Slice m covers the headings within half a slice
+  width of m * 2 * pi / num_headings. A bit is set if some robot pose with its
+  origin in the cell and its heading in the slice brings a circle closer than
+  the inflation radius to an obstacle cell, or outside the map. The test is
+  conservative: the circles are grown by the cell diagonal and by the
+  distance a vertex travels when the heading sweeps half a slice.
+
+  The bitmaps are computed from an array with one byte per cell, non-zero for
+  obstacle cells, and can be recomputed on a window of cells when only part
+  of the map changes.
+
+  \ingroup collision_checkers
+*/
+class HeadingBitmaps {
+
+  // A run of cells [dx_min, dx_max] on the row dy of a slice mask.
+  struct MaskRun {
+    int dy;
+    int dx_min;
+    int dx_max;
+  };
+
+  int num_headings;
+  int size_x;
+  int size_y;
+  int words_per_row;
+
+  // Largest offset, in cells, of any mask run.
+  int extent;
+
+  // Cell offsets that have to be free for each heading slice.
+  std::vector<std::vector<MaskRun>> masks;
+
+  // One bit per cell for each heading slice, row-major, rows padded to a
+  // whole number of words.
+  std::vector<std::vector<uint64_t>> slices;
+
+  // Scratch buffer for the row-wise prefix counts of obstacle cells.
+  std::vector<int> prefix_counts;
+
+public:
+  HeadingBitmaps();
+  ~HeadingBitmaps();
+
+  /**
+   * \brief Computes the cell masks of all heading slices.
+   *
+   * The bitmaps are invalidated and must be recomputed with update().
+   *
+   * @param footprint Vertices of the footprint in the robot frame.
+   * @param inflation_radius Radius of the circles placed on the vertices.
+   * @param resolution Size of a cell in meters.
+   * @param num_headings_in Number of heading slices.
+   *
+   * @returns Returns 1 for success, a non-positive value to indicate error.
+   */
+  int set_footprint(const std::vector<std::array<double, 2>> &footprint,
+                    double inflation_radius, double resolution,
+                    int num_headings_in);
+
+  /**
+   * \brief Sets the number of cells of the map and clears the bitmaps.
+   */
+  void resize(int size_x_in, int size_y_in);
+
+  /**
+   * \brief Recomputes the bits of the cells in a rectangle.
+   *
+   * Recomputes the bits of the cells in [x_min, x_max) x [y_min, y_max) for
+   * all heading slices. Obstacles up to get_extent() cells away from the
+   * rectangle are taken into account.
+   *
+   * @param obstacles Row-major array with one byte per cell, non-zero for
+   *                  obstacle cells.
+   *
+   * @returns Returns 1 for success, a non-positive value to indicate error.
+   */
+  int update(const unsigned char *obstacles, int x_min, int y_min, int x_max,
+             int y_max);
+
+  /**
+   * \brief Returns the heading slice that contains the given heading.
+   */
+  inline int get_slice(double theta) const {
+    int slice = (int)floor(theta * num_headings / (2.0 * M_PI) + 0.5) %
+                num_headings;
+    return (slice < 0) ? slice + num_headings : slice;
+  }
+
+  /**
+   * \brief Tests the bit of a cell, which must lie inside the map.
+   *
+   * @returns Returns true if a robot pose with its origin in the cell and
+   *          the given heading may be in collision.
+   */
+  inline bool is_occupied(int cell_x, int cell_y, double theta) const {
+    const uint64_t word =
+        slices[get_slice(theta)][cell_y * words_per_row + (cell_x >> 6)];
+    return (word >> (cell_x & 63)) & 1;
+  }
+
+  inline int get_num_headings() const { return num_headings; }
+  inline int get_extent() const { return extent; }
+};
+} // namespace collision_checkers
+} // namespace smp
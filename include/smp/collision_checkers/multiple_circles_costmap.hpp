@@ -0,0 +1,679 @@
+/*! \file components/collision_checkers/multiple_circles_costmap.h
+  \brief A collision checker using multiple circles on a raw 2D costmap
+
+  This file implements a collision checker that works directly on the cost
+  array of a 2D costmap (e.g., costmap_2d::Costmap2D::getCharMap()), without
+  copying it into another map representation.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <smp/collision_checkers/base.hpp>
+#include <smp/collision_checkers/heading_bitmaps.hpp>
+#include <smp/collision_checkers/occupancy_pyramid.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <vector>
+
+namespace smp {
+namespace collision_checkers {
+
+//! Costmap collision checker using a robot footprint.
+/*!
+  Checks for collisions between a robot footprint and a 2D costmap given as a
+  row-major array of unsigned char costs. The array is not copied: the cell
+  under each footprint vertex is read directly from it, so lethal cells are
+  honored as soon as the costmap marks them. A cell is an obstacle if its cost
+  is greater than or equal to the lethal cost threshold.
+
+  In addition, the checker keeps its own clearance field, i.e., the distance
+  from every cell to the nearest obstacle, truncated at the inflation radius.
+  A footprint vertex whose clearance is less than the inflation radius is in
+  collision. The clearance field is computed by update_clearance(). When the
+  costmap changes, sync() finds the window of cells whose obstacle status
+  changed since the last update and recomputes the clearance only around it.
+
+  Optionally, the checker precomputes configuration-space obstacle bitmaps
+  for a number of discretized headings (see HeadingBitmaps), which sync()
+  keeps up to date together with the clearance field. A state is then checked
+  with a single bit lookup. The bitmaps reflect the costmap as of the last
+  call to sync(), which recomputes them only on the tiles of cells within
+  reach of the cells whose obstacle status changed.
+
+  Cells outside the map are obstacles: a state outside the map collides, and
+  so does a state whose footprint, as modeled by the bitmaps, reaches past
+  the border of the map.
+
+  A list of states is first checked against an occupancy pyramid of the
+  obstacle cells, also kept up to date by sync(), so that stretches of a
+  trajectory far from any obstacle are accepted without per-state checks.
+  The steps of an extension are checked against the pyramid one state at a
+  time, unless the heading bitmaps answer with a single lookup.
+
+  \ingroup collision_checkers
+*/
+template <class State> class MultipleCirclesCostmap : public Base<State> {
+
+  // The costmap, which is owned by the user.
+  const unsigned char *costs;
+  int size_x;
+  int size_y;
+  double resolution;
+  double origin_x;
+  double origin_y;
+
+  unsigned char lethal_cost;
+  double inflation_radius;
+
+  std::vector<std::array<double, 2>> robot_footprint;
+
+  // Largest distance of a footprint vertex from the robot origin.
+  double footprint_radius;
+
+  // Clearance of each cell in meters, truncated at the inflation radius.
+  std::vector<float> clearance;
+
+  // Obstacle status (1 for lethal) of each cell when the clearance field was
+  // last computed, and whether the clearance field is valid at all.
+  std::vector<unsigned char> lethal;
+  bool clearance_valid;
+
+  // Cells whose obstacle status changed in the last call to sync(), as an
+  // inclusive rectangle; empty if x_min > x_max.
+  int sync_x_min, sync_y_min, sync_x_max, sync_y_max;
+
+  // Number of heading slices of the bitmaps, 0 if they are disabled.
+  int num_headings;
+  HeadingBitmaps heading_bitmaps;
+
+  // Side, in cells, of the square tiles on which sync() recomputes the
+  // heading bitmaps.
+  static const int BITMAP_TILE_SIZE = 32;
+
+  // Number of tiles along each axis, the tiles with cells whose obstacle
+  // status changed since the bitmaps were last updated, and the tiles whose
+  // bits they affect.
+  int tiles_x, tiles_y;
+  std::vector<unsigned char> tiles_changed;
+  std::vector<unsigned char> tiles_affected;
+
+  // Recomputes the heading bitmaps on the tiles within the extent of the
+  // masks of the changed tiles, and clears the changed tiles.
+  void update_heading_bitmaps() {
+
+    int reach_tiles =
+        (heading_bitmaps.get_extent() + BITMAP_TILE_SIZE - 1) /
+        BITMAP_TILE_SIZE;
+
+    tiles_affected.assign(tiles_x * tiles_y, 0);
+    for (int ty = 0; ty < tiles_y; ty++) {
+      for (int tx = 0; tx < tiles_x; tx++) {
+        if (!tiles_changed[ty * tiles_x + tx])
+          continue;
+        tiles_changed[ty * tiles_x + tx] = 0;
+        for (int ay = std::max(ty - reach_tiles, 0);
+             ay <= std::min(ty + reach_tiles, tiles_y - 1); ay++)
+          for (int ax = std::max(tx - reach_tiles, 0);
+               ax <= std::min(tx + reach_tiles, tiles_x - 1); ax++)
+            tiles_affected[ay * tiles_x + ax] = 1;
+      }
+    }
+
+    // Consecutive affected tiles of a row are recomputed together.
+    for (int ty = 0; ty < tiles_y; ty++) {
+      int tx = 0;
+      while (tx < tiles_x) {
+        if (!tiles_affected[ty * tiles_x + tx]) {
+          tx++;
+          continue;
+        }
+        int tx_end = tx;
+        while ((tx_end < tiles_x) && tiles_affected[ty * tiles_x + tx_end])
+          tx_end++;
+        heading_bitmaps.update(lethal.data(), tx * BITMAP_TILE_SIZE,
+                               ty * BITMAP_TILE_SIZE,
+                               tx_end * BITMAP_TILE_SIZE,
+                               (ty + 1) * BITMAP_TILE_SIZE);
+        tx = tx_end;
+      }
+    }
+  }
+
+  OccupancyPyramid occupancy_pyramid;
+
+  // Fine check used by the occupancy pyramid.
+  struct StateCheck {
+    MultipleCirclesCostmap *checker;
+    inline int operator()(State *state) {
+      return checker->check_collision(state);
+    }
+  };
+
+  // Scratch buffer for the states of a trajectory.
+  std::vector<State *> state_buffer;
+
+  // Scratch buffers for the distance transform.
+  std::vector<float> dt_envelope_z;
+  std::vector<int> dt_envelope_v;
+
+  // One-dimensional squared Euclidean distance transform (Felzenszwalb and
+  // Huttenlocher) of the n values in f, written to d.
+  void distance_transform_1d(const float *f, float *d, int n) {
+
+    dt_envelope_v.resize(n);
+    dt_envelope_z.resize(n + 1);
+    int *v = dt_envelope_v.data();
+    float *z = dt_envelope_z.data();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    int k = -1;
+    for (int q = 0; q < n; q++) {
+      if (f[q] == inf) // Unreachable cells do not contribute a parabola.
+        continue;
+      if (k < 0) {
+        k = 0;
+        v[0] = q;
+        z[0] = -inf;
+        z[1] = inf;
+        continue;
+      }
+      double s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) /
+                 (2.0 * (q - v[k]));
+      while (s <= z[k]) {
+        k--;
+        s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) /
+            (2.0 * (q - v[k]));
+      }
+      k++;
+      v[k] = q;
+      z[k] = (float)s;
+      z[k + 1] = inf;
+    }
+
+    if (k < 0) {
+      for (int q = 0; q < n; q++)
+        d[q] = inf;
+      return;
+    }
+
+    k = 0;
+    for (int q = 0; q < n; q++) {
+      while (z[k + 1] < q)
+        k++;
+      d[q] = (float)((q - v[k]) * (q - v[k])) + f[v[k]];
+    }
+  }
+
+public:
+  inline MultipleCirclesCostmap()
+      : costs(NULL), size_x(0), size_y(0), resolution(0.05), origin_x(0.0),
+        origin_y(0.0), lethal_cost(254), inflation_radius(1.0),
+        footprint_radius(0.0), clearance_valid(false), sync_x_min(0),
+        sync_y_min(0), sync_x_max(-1), sync_y_max(-1), num_headings(0),
+        tiles_x(0), tiles_y(0) {}
+
+  inline ~MultipleCirclesCostmap() {}
+
+  /**
+   * \brief Sets the costmap that this collision checker reads.
+   *
+   * The costmap is not copied; the pointer must remain valid for as long as
+   * this collision checker is used. If the size of the map changes, the
+   * clearance field is invalidated and is recomputed entirely by the next
+   * call to sync().
+   *
+   * @param costs_in Row-major array of size_x_in * size_y_in cell costs.
+   * @param size_x_in Number of cells along the x axis.
+   * @param size_y_in Number of cells along the y axis.
+   * @param resolution_in Size of a cell in meters.
+   * @param origin_x_in World x coordinate of the lower-left map corner.
+   * @param origin_y_in World y coordinate of the lower-left map corner.
+   */
+  void set_map(const unsigned char *costs_in, int size_x_in, int size_y_in,
+               double resolution_in, double origin_x_in, double origin_y_in) {
+
+    costs = costs_in;
+    if ((size_x_in != size_x) || (size_y_in != size_y)) {
+      size_x = size_x_in;
+      size_y = size_y_in;
+      clearance.assign(size_x * size_y, 0.0f);
+      lethal.assign(size_x * size_y, 0);
+      clearance_valid = false;
+    }
+    if (resolution_in != resolution)
+      clearance_valid = false;
+    resolution = resolution_in;
+    origin_x = origin_x_in;
+    origin_y = origin_y_in;
+    occupancy_pyramid.set_origin(origin_x, origin_y);
+  }
+
+  /**
+   * \brief Recomputes the clearance field from the costmap.
+   *
+   * Computes the exact Euclidean distance from every cell to the nearest
+   * obstacle cell in the rectangle of cells [x_min, x_max) x [y_min, y_max),
+   * truncated at the inflation radius. Obstacles outside the rectangle are
+   * taken into account up to the inflation radius away from it. Calling the
+   * function without arguments recomputes the whole map.
+   *
+   * @returns Returns 1 for success, a non-positive value to indicate error.
+   */
+  int update_clearance(int x_min = 0, int y_min = 0,
+                       int x_max = std::numeric_limits<int>::max(),
+                       int y_max = std::numeric_limits<int>::max()) {
+
+    if (!costs) {
+      std::cerr << "[update_clearance]: NO MAP!\n";
+      return 0;
+    }
+
+    x_min = std::max(x_min, 0);
+    y_min = std::max(y_min, 0);
+    x_max = std::min(x_max, size_x);
+    y_max = std::min(y_max, size_y);
+    if ((x_min >= x_max) || (y_min >= y_max))
+      return 1;
+
+    // Obstacles further than the inflation radius do not change the
+    // truncated clearance, so only a margin around the rectangle is read.
+    int margin = (int)ceil(inflation_radius / resolution) + 1;
+    int wx_min = std::max(x_min - margin, 0);
+    int wy_min = std::max(y_min - margin, 0);
+    int wx_max = std::min(x_max + margin, size_x);
+    int wy_max = std::min(y_max + margin, size_y);
+    int width = wx_max - wx_min;
+    int height = wy_max - wy_min;
+
+    const float inf = std::numeric_limits<float>::infinity();
+    std::vector<float> grid(width * height);
+    std::vector<float> line_in(std::max(width, height));
+    std::vector<float> line_out(std::max(width, height));
+
+    // 1. Transform the columns of the window.
+    for (int x = 0; x < width; x++) {
+      for (int y = 0; y < height; y++)
+        line_in[y] =
+            (costs[(wy_min + y) * size_x + wx_min + x] >= lethal_cost) ? 0.0f
+                                                                      : inf;
+      distance_transform_1d(line_in.data(), line_out.data(), height);
+      for (int y = 0; y < height; y++)
+        grid[y * width + x] = line_out[y];
+    }
+
+    // 2. Transform the rows, and store the truncated clearance for the cells
+    // in the requested rectangle.
+    float clearance_max = (float)inflation_radius;
+    for (int y = y_min - wy_min; y < y_max - wy_min; y++) {
+      distance_transform_1d(&grid[y * width], line_out.data(), width);
+      float *clearance_row = &clearance[(wy_min + y) * size_x];
+      for (int x = x_min - wx_min; x < x_max - wx_min; x++)
+        clearance_row[wx_min + x] = std::min(
+            (float)(sqrt(line_out[x]) * resolution), clearance_max);
+    }
+
+    // 3. Remember the obstacle status the rectangle was computed from.
+    for (int y = y_min; y < y_max; y++) {
+      const unsigned char *costs_row = &costs[y * size_x];
+      unsigned char *lethal_row = &lethal[y * size_x];
+      for (int x = x_min; x < x_max; x++)
+        lethal_row[x] = (costs_row[x] >= lethal_cost);
+    }
+
+    if ((x_min == 0) && (y_min == 0) && (x_max == size_x) &&
+        (y_max == size_y))
+      clearance_valid = true;
+
+    return 1;
+  }
+
+  /**
+   * \brief Brings the clearance field up to date with the costmap.
+   *
+   * Compares the obstacle status of the cells in the rectangle
+   * [x_min, x_max) x [y_min, y_max) with the one the clearance field was
+   * computed from. The clearance field is then recomputed only on the
+   * bounding box of the changed cells, grown by the inflation radius. If the
+   * clearance field has never been computed, or the map size, the lethal
+   * cost or the inflation radius changed, the whole map is recomputed.
+   * Calling the function without arguments scans the whole map.
+   *
+   * @returns Returns the number of cells whose obstacle status changed, or
+   *          a negative value to indicate error.
+   */
+  int sync(int x_min = 0, int y_min = 0,
+           int x_max = std::numeric_limits<int>::max(),
+           int y_max = std::numeric_limits<int>::max()) {
+
+    if (!costs) {
+      std::cerr << "[sync]: NO MAP!\n";
+      return -1;
+    }
+
+    sync_x_min = sync_y_min = 0;
+    sync_x_max = sync_y_max = -1;
+
+    if (!clearance_valid) {
+      sync_x_max = size_x - 1;
+      sync_y_max = size_y - 1;
+      update_clearance();
+      occupancy_pyramid.resize(size_x, size_y, resolution, origin_x,
+                               origin_y);
+      occupancy_pyramid.update(lethal.data(), 0, 0, size_x, size_y);
+      if (num_headings > 0) {
+        heading_bitmaps.set_footprint(robot_footprint, inflation_radius,
+                                      resolution, num_headings);
+        heading_bitmaps.resize(size_x, size_y);
+        heading_bitmaps.update(lethal.data(), 0, 0, size_x, size_y);
+        tiles_x = (size_x + BITMAP_TILE_SIZE - 1) / BITMAP_TILE_SIZE;
+        tiles_y = (size_y + BITMAP_TILE_SIZE - 1) / BITMAP_TILE_SIZE;
+        tiles_changed.assign(tiles_x * tiles_y, 0);
+      }
+      return size_x * size_y;
+    }
+
+    x_min = std::max(x_min, 0);
+    y_min = std::max(y_min, 0);
+    x_max = std::min(x_max, size_x);
+    y_max = std::min(y_max, size_y);
+
+    int num_changed = 0;
+    int dirty_x_min = x_max, dirty_y_min = y_max;
+    int dirty_x_max = x_min - 1, dirty_y_max = y_min - 1;
+    for (int y = y_min; y < y_max; y++) {
+      const unsigned char *costs_row = &costs[y * size_x];
+      const unsigned char *lethal_row = &lethal[y * size_x];
+      int row_changed = 0;
+      int row_x_min = x_max, row_x_max = x_min - 1;
+      for (int x = x_min; x < x_max; x++) {
+        if ((costs_row[x] >= lethal_cost) != (lethal_row[x] != 0)) {
+          row_changed++;
+          row_x_min = std::min(row_x_min, x);
+          row_x_max = x;
+          if (num_headings > 0)
+            tiles_changed[(y / BITMAP_TILE_SIZE) * tiles_x +
+                          x / BITMAP_TILE_SIZE] = 1;
+        }
+      }
+      if (row_changed) {
+        num_changed += row_changed;
+        dirty_x_min = std::min(dirty_x_min, row_x_min);
+        dirty_x_max = std::max(dirty_x_max, row_x_max);
+        dirty_y_min = std::min(dirty_y_min, y);
+        dirty_y_max = y;
+      }
+    }
+
+    if (num_changed == 0)
+      return 0;
+
+    sync_x_min = dirty_x_min;
+    sync_y_min = dirty_y_min;
+    sync_x_max = dirty_x_max;
+    sync_y_max = dirty_y_max;
+
+    // A changed cell affects the clearance up to the inflation radius away.
+    int margin = (int)ceil(inflation_radius / resolution) + 1;
+    update_clearance(dirty_x_min - margin, dirty_y_min - margin,
+                     dirty_x_max + 1 + margin, dirty_y_max + 1 + margin);
+    occupancy_pyramid.update(lethal.data(), dirty_x_min, dirty_y_min,
+                             dirty_x_max + 1, dirty_y_max + 1);
+
+    // The changes may be scattered over the map, so the bitmaps are only
+    // recomputed around the tiles that changed, not on the bounding box.
+    if (num_headings > 0)
+      update_heading_bitmaps();
+
+    return num_changed;
+  }
+
+  /**
+   * \brief Returns the clearance of the cell containing the given point.
+   *
+   * @returns Returns the distance to the nearest obstacle in meters,
+   *          truncated at the inflation radius, or 0 if the point lies
+   *          outside the map or in a lethal cell.
+   */
+  inline double get_clearance(double x, double y) const {
+
+    int cell_x = (int)floor((x - origin_x) / resolution);
+    int cell_y = (int)floor((y - origin_y) / resolution);
+    if ((cell_x < 0) || (cell_y < 0) || (cell_x >= size_x) ||
+        (cell_y >= size_y))
+      return 0.0;
+
+    int index = cell_y * size_x + cell_x;
+    if (costs[index] >= lethal_cost)
+      return 0.0;
+
+    return clearance[index];
+  }
+
+  /**
+   * \brief Marks the cells where the robot origin can be placed.
+   *
+   * A cell is marked free if it is not lethal and its clearance is at least
+   * the inflation radius, i.e., if it passes the first test of
+   * check_collision. The footprint itself is not tested.
+   *
+   * @param free_mask_out Row-major mask of size_x * size_y bytes, 1 for the
+   *                      free cells and 0 otherwise.
+   *
+   * @returns Returns the number of free cells, or a negative number if the
+   *          clearance field is not valid.
+   */
+  int get_free_cells(std::vector<unsigned char> &free_mask_out) const {
+
+    if (!costs || !clearance_valid) {
+      std::cerr << "[get_free_cells]: CLEARANCE FIELD IS NOT VALID!\n";
+      return -1;
+    }
+
+    int num_free = 0;
+    free_mask_out.resize(size_x * size_y);
+    for (int index = 0; index < size_x * size_y; index++) {
+      free_mask_out[index] = (costs[index] < lethal_cost) &&
+                             (clearance[index] >= (float)inflation_radius);
+      num_free += free_mask_out[index];
+    }
+
+    return num_free;
+  }
+
+  int check_collision(State *state_in) {
+
+    if (!costs) {
+      std::cerr << "[check_collision]: NO MAP!\n";
+      return 1;
+    }
+
+    double x = state_in->state_vars[0];
+    double y = state_in->state_vars[1];
+    double theta = state_in->state_vars[2];
+
+    if ((num_headings > 0) && clearance_valid) {
+      int cell_x = (int)floor((x - origin_x) / resolution);
+      int cell_y = (int)floor((y - origin_y) / resolution);
+      if ((cell_x < 0) || (cell_y < 0) || (cell_x >= size_x) ||
+          (cell_y >= size_y))
+        return 0;
+      return heading_bitmaps.is_occupied(cell_x, cell_y, theta) ? 0 : 1;
+    }
+
+    // The clearance field holds floats, so the radius is rounded the same
+    // way, or a clearance that equals the radius would collide.
+    if (get_clearance(x, y) < (float)inflation_radius)
+      return 0;
+
+    double cos_theta = cos(theta);
+    double sin_theta = sin(theta);
+    for (const auto &vertex : robot_footprint) {
+      double vertex_x = x + vertex[0] * cos_theta - vertex[1] * sin_theta;
+      double vertex_y = y + vertex[0] * sin_theta + vertex[1] * cos_theta;
+
+      if (get_clearance(vertex_x, vertex_y) < (float)inflation_radius)
+        return 0;
+    }
+
+    return 1;
+  }
+
+  int check_collision(const std::list<State *> &list_states) {
+
+    if (!costs) {
+      std::cerr << "[check_collision]: NO MAP!\n";
+      return 1;
+    }
+
+    if (!clearance_valid) {
+      for (const auto &iter : list_states) {
+        if (check_collision(iter) == 0) {
+          return 0;
+        }
+      }
+      return 1;
+    }
+
+    state_buffer.assign(list_states.begin(), list_states.end());
+    StateCheck state_check = {this};
+    return occupancy_pyramid.check_states(state_buffer.data(),
+                                          (int)state_buffer.size(),
+                                          get_reach(), state_check);
+  }
+
+  // Trajectories are checked state by state, so a step only needs the state
+  // that it reaches. Without heading bitmaps, the occupancy pyramid accepts
+  // a state far from any obstacle before its footprint is checked.
+  int check_collision_step(State * /*state_prev_in*/, State *state_curr_in) {
+
+    if (!costs || !clearance_valid || (num_headings > 0))
+      return check_collision(state_curr_in);
+
+    StateCheck state_check = {this};
+    return occupancy_pyramid.check_states(&state_curr_in, 1, get_reach(),
+                                          state_check);
+  }
+
+  /**
+   * \brief Returns how far from the robot origin a state check looks.
+   *
+   * A state check depends only on the cells within this distance from the
+   * position of the state.
+   */
+  inline double get_reach() const {
+    // The footprint radius plus the inflation radius, and one more cell for
+    // rounding. The heading bitmaps look as far as the extent of their masks.
+    double reach = footprint_radius + inflation_radius + resolution;
+    if (num_headings > 0)
+      reach = std::max(reach, heading_bitmaps.get_extent() * resolution);
+    return reach;
+  }
+
+  /**
+   * \brief Returns the region of the map changed in the last call to sync().
+   *
+   * @returns Returns 1 and the bounds in world coordinates of the cells whose
+   *          obstacle status changed, or 0 if none changed.
+   */
+  int get_sync_window(double *x_min, double *y_min, double *x_max,
+                      double *y_max) const {
+    if ((sync_x_min > sync_x_max) || (sync_y_min > sync_y_max))
+      return 0;
+    *x_min = origin_x + sync_x_min * resolution;
+    *y_min = origin_y + sync_y_min * resolution;
+    *x_max = origin_x + (sync_x_max + 1) * resolution;
+    *y_max = origin_y + (sync_y_max + 1) * resolution;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the robot footprint.
+   *
+   * The footprint is given as a list of (x, y) vertices in the robot frame.
+   * A circle of radius equal to the inflation radius is placed on each
+   * vertex and on the origin of the robot frame.
+   */
+  inline void
+  set_robot_footprint(const std::vector<std::array<double, 2>> &footprint) {
+    robot_footprint = footprint;
+    footprint_radius = 0.0;
+    for (const auto &vertex : robot_footprint)
+      footprint_radius =
+          std::max(footprint_radius, sqrt(vertex[0] * vertex[0] +
+                                          vertex[1] * vertex[1]));
+    if (num_headings > 0)
+      clearance_valid = false;
+  }
+
+  /**
+   * \brief Enables the per-heading configuration-space obstacle bitmaps.
+   *
+   * The bitmaps use one bit per cell and heading slice, and are computed by
+   * the next call to sync(). Until then, states are checked against the
+   * clearance field. The bitmaps treat the cells outside the map as
+   * obstacles, so the poses near the border of the map whose footprint
+   * reaches past it collide.
+   *
+   * @param num_headings_in Number of heading slices, or 0 to disable the
+   *                        bitmaps.
+   */
+  inline void set_num_headings(int num_headings_in) {
+    num_headings = std::max(num_headings_in, 0);
+    clearance_valid = false;
+  }
+
+  /**
+   * \brief Sets the inflation radius.
+   *
+   * The clearance field is truncated at the inflation radius, hence it is
+   * recomputed entirely by the next call to sync().
+   */
+  inline void set_inflation_radius(double radius) {
+    inflation_radius = radius;
+    clearance_valid = false;
+  }
+
+  /**
+   * \brief Sets the cost at or above which a cell is an obstacle.
+   *
+   * The default, 254, treats lethal (254) and unknown (255) costmap_2d cells
+   * as obstacles. The clearance field is recomputed entirely by the next
+   * call to sync().
+   */
+  inline void set_lethal_cost(unsigned char cost) {
+    lethal_cost = cost;
+    clearance_valid = false;
+  }
+
+  inline double get_inflation_radius() const { return inflation_radius; }
+  inline int get_num_headings() const { return num_headings; }
+  inline unsigned char get_lethal_cost() const { return lethal_cost; }
+  inline int get_size_x() const { return size_x; }
+  inline int get_size_y() const { return size_y; }
+  inline double get_resolution() const { return resolution; }
+  inline double get_origin_x() const { return origin_x; }
+  inline double get_origin_y() const { return origin_y; }
+};
+} // namespace collision_checkers
+} // namespace smp
@@ -27,10 +27,13 @@
 #include <mrpt/maps/COccupancyGridMap2D.h>
 #include <mrpt/math/CPolygon.h>
 #include <smp/collision_checkers/base.hpp>
+#include <smp/collision_checkers/occupancy_pyramid.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace smp {
 namespace collision_checkers {
@@ -40,6 +43,15 @@ namespace mm = mrpt::maps;
 //! MRPT Occupancy map collision checker using a robot footprint.
 /*!
   Checks for collisions between a robot footprint and the MRPT occupancy map.
+
+  A list of states is first checked against an occupancy pyramid of the map,
+  so that stretches of a trajectory far from any obstacle are accepted without
+  per-state clearance computations. Cells with a free probability of at most
+  0.5 are treated as occupied by the pyramid. The pyramid is built when the
+  map is set, and must be refreshed with update_occupancy_pyramid() when
+  cells of the map change. The steps of an extension are checked against the
+  pyramid one state at a time.
+
   \ingroup collision_checkers
 */
 template <class State> class MultipleCirclesMRPT : public Base<State> {
@@ -48,12 +60,39 @@ template <class State> class MultipleCirclesMRPT : public Base<State> {
   double inflation_radius;
   std::shared_ptr<mrpt::math::CPolygon> robot_footprint;
 
+  OccupancyPyramid occupancy_pyramid;
+
+  // Fine check used by the occupancy pyramid.
+  struct StateCheck {
+    MultipleCirclesMRPT *checker;
+    inline int operator()(State *state) {
+      return checker->check_collision(state);
+    }
+  };
+
+  // Scratch buffer for the states of a trajectory.
+  std::vector<State *> state_buffer;
+
+  // Largest distance of a footprint vertex from the robot origin.
+  double get_footprint_radius() const {
+    std::vector<double> xCoords, yCoords;
+    robot_footprint->getAllVertices(xCoords, yCoords);
+
+    double radius = 0.0;
+    for (size_t i = 0; i < xCoords.size(); i++)
+      radius = std::max(radius, sqrt(xCoords[i] * xCoords[i] +
+                                     yCoords[i] * yCoords[i]));
+    return radius;
+  }
+
 public:
   inline MultipleCirclesMRPT() : inflation_radius(1.0) {}
   inline MultipleCirclesMRPT(
       const std::shared_ptr<mm::COccupancyGridMap2D> &_map, double radius,
       const std::shared_ptr<mrpt::math::CPolygon> &footprint)
-      : map(_map), inflation_radius(radius), robot_footprint(footprint) {}
+      : map(_map), inflation_radius(radius), robot_footprint(footprint) {
+    build_occupancy_pyramid();
+  }
 
   inline ~MultipleCirclesMRPT() {}
 
@@ -108,12 +147,72 @@ public:
       return 1;
 
     // This might be a problem with very thin obstacles. We ignore that for now.
-    for (const auto &iter : list_states) {
-      if (check_collision(iter) == 0) {
-        // std::cout << "()()()()\n";
-        return 0;
-      }
+    // The fine check looks at cells up to the footprint radius plus the
+    // inflation radius away, and one more cell accounts for rounding.
+    state_buffer.assign(list_states.begin(), list_states.end());
+    StateCheck state_check = {this};
+    return occupancy_pyramid.check_states(
+        state_buffer.data(), (int)state_buffer.size(),
+        get_footprint_radius() + inflation_radius + map->getResolution(),
+        state_check);
+  }
+
+  // Trajectories are checked state by state, so a step only needs the state
+  // that it reaches, which is first checked against the occupancy pyramid.
+  int check_collision_step(State * /*state_prev_in*/, State *state_curr_in) {
+
+    if (!map || !robot_footprint)
+      return check_collision(state_curr_in);
+
+    StateCheck state_check = {this};
+    return occupancy_pyramid.check_states(
+        &state_curr_in, 1,
+        get_footprint_radius() + inflation_radius + map->getResolution(),
+        state_check);
+  }
+
+  /**
+   * \brief Builds the occupancy pyramid from the whole map.
+   *
+   * @returns Returns 1 for success, a non-positive value to indicate error.
+   */
+  int build_occupancy_pyramid() {
+
+    if (!map) {
+      std::cerr << "[build_occupancy_pyramid]: NO MAP!\n";
+      return 0;
     }
+
+    occupancy_pyramid.resize(map->getSizeX(), map->getSizeY(),
+                             map->getResolution(), map->getXMin(),
+                             map->getYMin());
+    return update_occupancy_pyramid(0, 0, map->getSizeX(), map->getSizeY());
+  }
+
+  /**
+   * \brief Refreshes the occupancy pyramid after cells of the map changed.
+   *
+   * Reads the cells in [x_min, x_max) x [y_min, y_max) from the map and
+   * updates the pyramid in place.
+   *
+   * @returns Returns 1 for success, a non-positive value to indicate error.
+   */
+  int update_occupancy_pyramid(int x_min, int y_min, int x_max, int y_max) {
+
+    if (!map) {
+      std::cerr << "[update_occupancy_pyramid]: NO MAP!\n";
+      return 0;
+    }
+
+    x_min = std::max(x_min, 0);
+    y_min = std::max(y_min, 0);
+    x_max = std::min(x_max, (int)map->getSizeX());
+    y_max = std::min(y_max, (int)map->getSizeY());
+
+    for (int y = y_min; y < y_max; y++)
+      for (int x = x_min; x < x_max; x++)
+        occupancy_pyramid.set_cell(x, y, map->getCell(x, y) <= 0.5f);
+
     return 1;
   }
 
@@ -123,6 +222,7 @@ public:
   }
   inline void set_map(const std::shared_ptr<mm::COccupancyGridMap2D> &_map) {
     map = _map;
+    build_occupancy_pyramid();
   }
   inline void set_inflation_radius(double radius) { inflation_radius = radius; }
 };
@@ -0,0 +1,182 @@
+/*! \file components/collision_checkers/occupancy_pyramid.h
+  \brief A multi-resolution occupancy pyramid over a 2D grid map
+
+  This file implements a max-pooled occupancy pyramid that answers whether a
+  rectangle of a 2D grid map is entirely free, without visiting every cell of
+  the rectangle.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace smp {
+namespace collision_checkers {
+
+//! Max-pooled occupancy pyramid.
+/*!
+  Level 0 holds one byte per cell of the grid map, non-zero for occupied
+  cells. Every cell of level l + 1 is occupied if and only if any of the 2x2
+  cells of level l that it covers is occupied. A rectangle query starts at the
+  finest level at which the rectangle spans at most 2x2 cells, accepts free
+  coarse cells right away and only descends into occupied ones.
+
+  The pyramid can be used by any grid-based collision checker: the checker
+  marks the occupied cells with set_cell() or update(), and accepts a
+  trajectory segment whose bounding box, grown by the robot radius, is free.
+
+  \ingroup collision_checkers
+*/
+class OccupancyPyramid {
+
+  int size_x;
+  int size_y;
+  double resolution;
+  double origin_x;
+  double origin_y;
+
+  std::vector<int> level_size_x;
+  std::vector<int> level_size_y;
+  std::vector<std::vector<unsigned char>> levels;
+
+  // Recomputes the cells of the given level covering the cells
+  // [x_min, x_max] x [y_min, y_max] of the level below.
+  void pool(int level, int x_min, int y_min, int x_max, int y_max);
+
+  // Tests the cells of the given level that intersect the rectangle of level
+  // 0 cells [x_min, x_max] x [y_min, y_max].
+  bool is_free_at(int level, int x_min, int y_min, int x_max,
+                  int y_max) const;
+
+public:
+  OccupancyPyramid();
+  ~OccupancyPyramid();
+
+  /**
+   * \brief Sets the size and the placement of the grid map.
+   *
+   * All cells are marked free.
+   *
+   * @param size_x_in Number of cells along the x axis.
+   * @param size_y_in Number of cells along the y axis.
+   * @param resolution_in Size of a cell in meters.
+   * @param origin_x_in World x coordinate of the lower-left map corner.
+   * @param origin_y_in World y coordinate of the lower-left map corner.
+   */
+  void resize(int size_x_in, int size_y_in, double resolution_in,
+              double origin_x_in, double origin_y_in);
+
+  /**
+   * \brief Sets the placement of the grid map without changing its cells.
+   */
+  void set_origin(double origin_x_in, double origin_y_in);
+
+  /**
+   * \brief Marks a single cell and updates the coarser levels in place.
+   */
+  void set_cell(int x, int y, bool occupied);
+
+  /**
+   * \brief Copies the cells of a rectangle and updates the coarser levels.
+   *
+   * Copies the cells in [x_min, x_max) x [y_min, y_max) from the given
+   * array and recomputes the coarser cells covering them.
+   *
+   * @param occupied Row-major array with one byte per cell, non-zero for
+   *                 occupied cells.
+   *
+   * @returns Returns 1 for success, a non-positive value to indicate error.
+   */
+  int update(const unsigned char *occupied, int x_min, int y_min, int x_max,
+             int y_max);
+
+  /**
+   * \brief Tests whether all cells in a rectangle of cells are free.
+   *
+   * @returns Returns 1 if every cell in [x_min, x_max] x [y_min, y_max] is
+   *          free, 0 if any of them is occupied or lies outside the map.
+   */
+  int is_free(int x_min, int y_min, int x_max, int y_max) const;
+
+  /**
+   * \brief Tests whether a rectangle in world coordinates is free.
+   *
+   * @returns Returns 1 if every cell that intersects the rectangle is free,
+   *          0 if any of them is occupied or lies outside the map.
+   */
+  int is_free(double x_min, double y_min, double x_max, double y_max) const;
+
+  /**
+   * \brief Checks a sequence of states hierarchically.
+   *
+   * The bounding box of the positions (the first two state variables) of
+   * the states, grown by the given radius, is tested with is_free(). If it
+   * is not free, the sequence is split in two halves that share their middle
+   * state, down to pairs of consecutive states, which are checked with the
+   * given fine collision check.
+   *
+   * @param states Array of num_states state pointers.
+   * @param radius Distance from the position of a state beyond which the
+   *               fine collision check does not look at the map.
+   * @param fine_check Callable that takes a state pointer and returns 1 if
+   *                   the state is collision free, 0 otherwise.
+   *
+   * @returns Returns 1 if all states are collision free, 0 otherwise.
+   */
+  template <class State, class FineCheck>
+  int check_states(State *const *states, int num_states, double radius,
+                   FineCheck &fine_check) const {
+
+    if (num_states <= 0)
+      return 1;
+
+    double x_min = states[0]->state_vars[0], x_max = x_min;
+    double y_min = states[0]->state_vars[1], y_max = y_min;
+    for (int i = 1; i < num_states; i++) {
+      x_min = std::min(x_min, states[i]->state_vars[0]);
+      x_max = std::max(x_max, states[i]->state_vars[0]);
+      y_min = std::min(y_min, states[i]->state_vars[1]);
+      y_max = std::max(y_max, states[i]->state_vars[1]);
+    }
+
+    if (is_free(x_min - radius, y_min - radius, x_max + radius,
+                y_max + radius))
+      return 1;
+
+    if (num_states <= 2) {
+      for (int i = 0; i < num_states; i++)
+        if (fine_check(states[i]) == 0)
+          return 0;
+      return 1;
+    }
+
+    int middle = num_states / 2;
+    if (check_states(states, middle + 1, radius, fine_check) == 0)
+      return 0;
+    return check_states(states + middle, num_states - middle, radius,
+                        fine_check);
+  }
+
+  inline int get_num_levels() const { return (int)levels.size(); }
+  inline int get_size_x() const { return size_x; }
+  inline int get_size_y() const { return size_y; }
+};
+} // namespace collision_checkers
+} // namespace smp
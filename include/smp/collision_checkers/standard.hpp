@@ -29,10 +29,100 @@
 
 #include <cmath>
 #include <list>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace smp {
 namespace collision_checkers {
 
+//! Number of obstacles processed together by the point-in-box kernels.
+/*!
+  The obstacle arrays of the standard collision checker are always padded to a
+  multiple of this number, so that the kernels never need a remainder loop.
+  Padding obstacles have a zero half-size, which no point can be inside of.
+*/
+#define _SMP_STANDARD_OBSTACLE_BLOCK 4
+
+//! Tests a batch of points against a set of axis-aligned boxes.
+/*!
+  The points and the boxes are both given in structure-of-arrays form:
+  points[i][k] is the i-th coordinate of the k-th point, while centers[i][j]
+  and half_sizes[i][j] are the i-th coordinate of the center and the i-th half
+  size of the j-th box. A point is inside a box if and only if it is strictly
+  inside along every axis. The number of boxes must be a multiple of
+  _SMP_STANDARD_OBSTACLE_BLOCK.
+
+  The loops over the dimensions have a compile-time trip count, so every
+  NUM_DIMENSIONS gets its own fully unrolled kernel. AVX2 and NEON versions
+  are selected at compile time, with a portable fallback.
+
+  @returns Returns 1 if no point is inside any box, 0 otherwise.
+*/
+template <int NUM_DIMENSIONS>
+inline int points_outside_boxes(const double *const *points, int num_points,
+                                const double *const *centers,
+                                const double *const *half_sizes,
+                                int num_boxes) {
+
+#if defined(__AVX2__)
+  const __m256d sign_mask = _mm256_set1_pd(-0.0);
+
+  for (int k = 0; k < num_points; k++) {
+    __m256d point[NUM_DIMENSIONS];
+    for (int i = 0; i < NUM_DIMENSIONS; i++)
+      point[i] = _mm256_set1_pd(points[i][k]);
+
+    for (int j = 0; j < num_boxes; j += 4) {
+      __m256d inside = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+      for (int i = 0; i < NUM_DIMENSIONS; i++) {
+        __m256d offset = _mm256_andnot_pd(
+            sign_mask, _mm256_sub_pd(point[i], _mm256_loadu_pd(centers[i] + j)));
+        inside = _mm256_and_pd(
+            inside, _mm256_cmp_pd(offset, _mm256_loadu_pd(half_sizes[i] + j),
+                                  _CMP_LT_OQ));
+      }
+      if (_mm256_movemask_pd(inside) != 0)
+        return 0;
+    }
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  for (int k = 0; k < num_points; k++) {
+    float64x2_t point[NUM_DIMENSIONS];
+    for (int i = 0; i < NUM_DIMENSIONS; i++)
+      point[i] = vdupq_n_f64(points[i][k]);
+
+    for (int j = 0; j < num_boxes; j += 2) {
+      uint64x2_t inside = vdupq_n_u64(~0ULL);
+      for (int i = 0; i < NUM_DIMENSIONS; i++) {
+        float64x2_t offset =
+            vabsq_f64(vsubq_f64(point[i], vld1q_f64(centers[i] + j)));
+        inside = vandq_u64(inside,
+                           vcltq_f64(offset, vld1q_f64(half_sizes[i] + j)));
+      }
+      if (vmaxvq_u32(vreinterpretq_u32_u64(inside)) != 0)
+        return 0;
+    }
+  }
+#else
+  for (int k = 0; k < num_points; k++) {
+    for (int j = 0; j < num_boxes; j++) {
+      bool inside = true;
+      for (int i = 0; i < NUM_DIMENSIONS; i++)
+        inside &= (fabs(points[i][k] - centers[i][j]) < half_sizes[i][j]);
+      if (inside)
+        return 0;
+    }
+  }
+#endif
+
+  return 1;
+}
+
 //! Standard collision checker
 /*!
   This class implements the standard collision checker. Standard collision
@@ -40,18 +130,24 @@ namespace collision_checkers {
   states. The said trajectory is obtained by a linear interpolation between
   the said states. Each interpolated state is, then, checked for collisioon
   with all the obstacles. This procedure is continued for all the states in
-  the trajectory. A single states is checked for collision by merely going
-  through the list of obstacles to check whether the query state resides
-  inside any of the obstacles.
+  the trajectory.
+
+  The obstacles are stored as structure-of-arrays (one array of centers and
+  one array of half sizes per dimension), and the interpolated states of a
+  segment are tested against all of them in batches using the
+  points_outside_boxes kernel.
 
   \ingroup collision_checkers
 */
 template <class State, class Input, int NUM_DIMENSIONS>
-class Standard : public Base<State, Input> {
+class Standard : public Base<State> {
 
   using trajectory_t = Trajectory<State, Input>;
   using region_t = Region<NUM_DIMENSIONS>;
 
+  // Maximum number of interpolated states handed to the kernel at once.
+  static const int point_batch_size = 64;
+
   int num_discretization_steps;
   double discretization_length;
 
@@ -60,129 +156,145 @@ class Standard : public Base<State, Input> {
   // 2: use length discretization
   int discretization_method;
 
-  std::list<region_t *> list_obstacles;
-
-public:
-  Standard() {
+  // Number of obstacles added by the user (excluding the padding).
+  int num_obstacles;
 
-    num_discretization_steps = 20;
-    discretization_length = 0.1;
-    discretization_method = 2;
-  }
+  std::vector<double> obstacle_centers[NUM_DIMENSIONS];
+  std::vector<double> obstacle_half_sizes[NUM_DIMENSIONS];
 
-  ~Standard() {
-    for (typename std::list<region_t *>::iterator iter = list_obstacles.begin();
-         iter != list_obstacles.end(); iter++) {
+  // Checks the points stored in the points argument against all obstacles.
+  int check_points(double (&points)[NUM_DIMENSIONS][point_batch_size],
+                   int num_points) {
 
-      region_t *region_curr = *iter;
-
-      delete region_curr;
+    const double *point_ptrs[NUM_DIMENSIONS];
+    const double *center_ptrs[NUM_DIMENSIONS];
+    const double *half_size_ptrs[NUM_DIMENSIONS];
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      point_ptrs[i] = points[i];
+      center_ptrs[i] = obstacle_centers[i].data();
+      half_size_ptrs[i] = obstacle_half_sizes[i].data();
     }
+
+    return points_outside_boxes<NUM_DIMENSIONS>(
+        point_ptrs, num_points, center_ptrs, half_size_ptrs,
+        (int)obstacle_centers[0].size());
   }
 
-  int check_collision(State *state_in) {
-    if (list_obstacles.size() == 0)
-      return 1;
+  // Queues the interpolated states of the segment from state_prev to
+  // state_curr, followed by state_curr, and flushes the batch to the kernel
+  // whenever it is full. Returns 0 as soon as a flushed batch collides.
+  int check_segment(State *state_prev, State *state_curr,
+                    double (&points)[NUM_DIMENSIONS][point_batch_size],
+                    int *num_points) {
+
+    // Compute the number of increments
+    int num_increments = 0;
+    double increments[NUM_DIMENSIONS];
+    if (discretization_method != 0) {
+      double dist_total = 0.0;
+      for (int i = 0; i < NUM_DIMENSIONS; i++) {
+        double increment_curr = (*state_curr)[i] - (*state_prev)[i];
+        dist_total += increment_curr * increment_curr;
+        increments[i] = increment_curr;
+      }
+      dist_total = sqrt(dist_total);
 
-    for (typename std::list<region_t *>::iterator iter = list_obstacles.begin();
-         iter != list_obstacles.end(); iter++) {
-      region_t *region_curr = *iter;
+      if (discretization_method == 1) {
+        num_increments = num_discretization_steps;
+      } else if (discretization_method == 2) {
+        num_increments = (int)floor(dist_total / discretization_length);
+      }
 
-      bool collision = true;
+      for (int i = 0; i < NUM_DIMENSIONS; i++) // Normalize the increments.
+        increments[i] = increments[i] / ((double)(num_increments + 1));
+    }
 
-      for (int i = 0; i < NUM_DIMENSIONS; i++) {
+    for (int idx_state = 1; idx_state <= num_increments + 1; idx_state++) {
 
-        if (fabs((*state_in)[i] - region_curr->center[i]) >=
-            region_curr->size[i] / 2.0)
-          collision = false;
+      if (*num_points == point_batch_size) {
+        if (check_points(points, *num_points) == 0)
+          return 0;
+        *num_points = 0;
       }
 
-      if (collision) {
-        return 0;
+      if (idx_state <= num_increments) {
+        for (int i = 0; i < NUM_DIMENSIONS; i++)
+          points[i][*num_points] = (*state_prev)[i] + increments[i] * idx_state;
+      } else {
+        for (int i = 0; i < NUM_DIMENSIONS; i++)
+          points[i][*num_points] = (*state_curr)[i];
       }
+      (*num_points)++;
     }
 
     return 1;
   }
 
+public:
+  Standard() {
+
+    num_discretization_steps = 20;
+    discretization_length = 0.1;
+    discretization_method = 2;
+    num_obstacles = 0;
+  }
+
+  ~Standard() {}
+
+  int check_collision(State *state_in) {
+    if (num_obstacles == 0)
+      return 1;
+
+    double points[NUM_DIMENSIONS][point_batch_size];
+    for (int i = 0; i < NUM_DIMENSIONS; i++)
+      points[i][0] = (*state_in)[i];
+
+    return check_points(points, 1);
+  }
+
   int check_collision(const std::list<State *> &list_states) {
 
-    if (list_obstacles.size() == 0)
+    if (num_obstacles == 0)
       return 1;
 
     if (list_states.size() == 0)
       return 1;
 
-    typename std::list<State *>::iterator iter = list_states.begin();
+    double points[NUM_DIMENSIONS][point_batch_size];
+    int num_points = 0;
 
-    State *state_prev = *iter;
+    typename std::list<State *>::const_iterator iter = list_states.begin();
 
-    if (this->check_collision(state_prev) == 0)
-      return 0;
+    State *state_prev = *iter;
+    for (int i = 0; i < NUM_DIMENSIONS; i++)
+      points[i][num_points] = (*state_prev)[i];
+    num_points++;
 
     iter++;
 
     for (; iter != list_states.end(); iter++) {
-
       State *state_curr = *iter;
-
-      if (discretization_method != 0) {
-        // Compute the increments
-        double dist_total = 0.0;
-        double increments[NUM_DIMENSIONS];
-        for (int i = 0; i < NUM_DIMENSIONS; i++) {
-          double increment_curr = (*state_curr)[i] - (*state_prev)[i];
-          dist_total += increment_curr * increment_curr;
-          increments[i] = increment_curr;
-        }
-        dist_total = sqrt(dist_total);
-
-        // Compute the number of increments
-        int num_increments;
-        if (discretization_method == 1) {
-          num_increments = num_discretization_steps;
-        } else if (discretization_method == 2) {
-          num_increments = (int)floor(dist_total / discretization_length);
-        }
-
-        // Execute the remaining only if the discretization is required.
-        if (num_increments > 0) {
-
-          for (int i = 0; i < NUM_DIMENSIONS; i++) // Normalize the increments.
-            increments[i] = increments[i] / ((double)(num_increments + 1));
-
-          for (typename std::list<region_t *>::iterator iter =
-                   list_obstacles.begin();
-               iter != list_obstacles.end(); iter++) {
-
-            region_t *region_curr = *iter;
-
-            for (int idx_state = 1; idx_state <= num_increments; idx_state++) {
-              bool collision = true;
-
-              for (int i = 0; i < NUM_DIMENSIONS; i++) {
-                if (fabs((*state_prev)[i] + increments[i] * idx_state -
-                         region_curr->center[i]) >=
-                    region_curr->size[i] / 2.0) {
-                  collision = false;
-                }
-              }
-              if (collision == true) {
-                return 0;
-              }
-            }
-          }
-        }
-      }
-
-      if (check_collision(state_curr) == 0) {
+      if (check_segment(state_prev, state_curr, points, &num_points) == 0)
         return 0;
-      }
-
       state_prev = state_curr;
     }
 
-    return 1;
+    return check_points(points, num_points);
+  }
+
+  // The step starts from a collision-free state, so only its interpolated
+  // states and the state that it reaches are checked.
+  int check_collision_step(State *state_prev_in, State *state_curr_in) {
+
+    if (num_obstacles == 0)
+      return 1;
+
+    double points[NUM_DIMENSIONS][point_batch_size];
+    int num_points = 0;
+    if (check_segment(state_prev_in, state_curr_in, points, &num_points) == 0)
+      return 0;
+
+    return check_points(points, num_points);
   }
 
   /**
@@ -251,7 +363,23 @@ public:
    */
   int add_obstacle(region_t &obstacle_in) {
 
-    list_obstacles.push_back(new region_t(obstacle_in));
+    // Grow the arrays by one block of padding obstacles when they are full.
+    if (num_obstacles == (int)obstacle_centers[0].size()) {
+      for (int i = 0; i < NUM_DIMENSIONS; i++) {
+        obstacle_centers[i].resize(num_obstacles +
+                                       _SMP_STANDARD_OBSTACLE_BLOCK,
+                                   0.0);
+        obstacle_half_sizes[i].resize(num_obstacles +
+                                          _SMP_STANDARD_OBSTACLE_BLOCK,
+                                      0.0);
+      }
+    }
+
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      obstacle_centers[i][num_obstacles] = obstacle_in.center[i];
+      obstacle_half_sizes[i][num_obstacles] = obstacle_in.size[i] / 2.0;
+    }
+    num_obstacles++;
 
     return 1;
   }
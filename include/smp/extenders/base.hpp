@@ -25,8 +25,10 @@
 #ifndef _SMP_EXTENDER_BASE_H_
 #define _SMP_EXTENDER_BASE_H_
 
+#include <smp/collision_checkers/base.hpp>
 #include <smp/trajectory.hpp>
 
+#include <cstddef>
 #include <list>
 
 namespace smp {
@@ -44,6 +46,8 @@ template <class State, class Input> class Base {
   using trajectory_t = Trajectory<State, Input>;
 
 public:
+  using collision_checker_t = collision_checkers::Base<State>;
+
   /**
    * \brief Abstract function that generates a trajectory connecting two given
    * states.
@@ -68,6 +72,182 @@ public:
   virtual int extend(State *state_from_in, State *state_towards_in,
                      int *exact_connection_out, trajectory_t *trajectory_out,
                      std::list<State *> *intermediate_vertices_out) = 0;
+
+  /**
+   * \brief Generates a trajectory connecting two given states, checking it
+   * for collision as it is generated.
+   *
+   * Every new state is passed to collision_checker.check_collision_step(),
+   * together with the state before it, and the extension stops at the first
+   * step that collides. The trajectory_out argument then holds the collision
+   * free prefix of the trajectory, which an RRT-like planner may add to its
+   * tree, and exact_connection_out is set to zero. The default
+   * implementation generates the whole trajectory with extend() and then
+   * checks it step by step; extenders that generate their trajectories
+   * incrementally override it to stop early.
+   *
+   * See extend() for the other arguments.
+   *
+   * @param collision_checker The collision checker for the steps.
+   *
+   * @returns Returns 1 if the trajectory is collision free, 0 if it collides
+   * and trajectory_out holds its free prefix, and a negative number if the
+   * extension fails.
+   */
+  virtual int extend_checked(State *state_from_in, State *state_towards_in,
+                             collision_checker_t &collision_checker,
+                             int *exact_connection_out,
+                             trajectory_t *trajectory_out,
+                             std::list<State *> *intermediate_vertices_out) {
+
+    if (extend(state_from_in, state_towards_in, exact_connection_out,
+               trajectory_out, intermediate_vertices_out) != 1)
+      return -1;
+
+    return truncate_at_collision(state_from_in, collision_checker,
+                                 exact_connection_out, trajectory_out,
+                                 intermediate_vertices_out);
+  }
+
+  /**
+   * \brief Returns a lower bound on the cost of connecting two states.
+   *
+   * The bound is in the units of the trajectory cost used by
+   * MinimumTimeReachability, i.e., the sum of the first input variable along
+   * the trajectory. It must never exceed the cost of any trajectory that
+   * extend() can generate from state_from_in to state_towards_in, so that it
+   * can be used to discard states that cannot improve a solution. The
+   * default implementation returns the trivial bound, 0.
+   *
+   * @param state_from_in The state that the trajectory starts from.
+   * @param state_towards_in The state that the trajectory reaches.
+   *
+   * @returns Returns a non-negative lower bound on the trajectory cost.
+   */
+  virtual double cost_lower_bound(State * /*state_from_in*/,
+                                  State * /*state_towards_in*/) {
+    return 0.0;
+  }
+
+  /**
+   * \brief Returns a lower bound on the cost of the trajectory that extend()
+   * generates from one state to another.
+   *
+   * Unlike cost_lower_bound(), the bound only needs to hold for the exact
+   * connection that extend() generates, so an extender that can compute the
+   * cost of its trajectory without generating it may return that cost. The
+   * planner calls this function to discard candidate extensions before
+   * generating them. The default implementation returns cost_lower_bound().
+   *
+   * @param state_from_in The state that the trajectory starts from.
+   * @param state_towards_in The state that the trajectory reaches.
+   *
+   * @returns Returns a non-negative lower bound on the trajectory cost.
+   */
+  virtual double cost_extend_lower_bound(State *state_from_in,
+                                         State *state_towards_in) {
+    return cost_lower_bound(state_from_in, state_towards_in);
+  }
+
+  /**
+   * \brief Computes cost_extend_lower_bound() from one state to a batch of
+   * states.
+   *
+   * If costs_max_in is not NULL, the bound of a state only needs to be exact
+   * enough to tell whether it is smaller than costs_max_in for that state,
+   * which lets the extender skip most of the work for the states that cannot
+   * be connected cheaply. The default implementation calls
+   * cost_extend_lower_bound() for every state.
+   *
+   * @param state_from_in The state that the trajectories start from.
+   * @param states_towards_in The states that the trajectories reach.
+   * @param num_states The number of states in the batch.
+   * @param costs_max_in The costs above which the bounds need not be exact,
+   *                     or NULL.
+   * @param bounds_out The bounds, one for every state in the batch.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  virtual int cost_extend_lower_bounds_from(State *state_from_in,
+                                            State **states_towards_in,
+                                            int num_states,
+                                            const double * /*costs_max_in*/,
+                                            double *bounds_out) {
+    for (int i = 0; i < num_states; i++)
+      bounds_out[i] =
+          cost_extend_lower_bound(state_from_in, states_towards_in[i]);
+    return 1;
+  }
+
+  /**
+   * \brief Computes cost_extend_lower_bound() from a batch of states to one
+   * state.
+   *
+   * See cost_extend_lower_bounds_from() for the arguments.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  virtual int cost_extend_lower_bounds_to(State **states_from_in,
+                                          State *state_towards_in,
+                                          int num_states,
+                                          const double * /*costs_max_in*/,
+                                          double *bounds_out) {
+    for (int i = 0; i < num_states; i++)
+      bounds_out[i] =
+          cost_extend_lower_bound(states_from_in[i], state_towards_in);
+    return 1;
+  }
+
+protected:
+  /**
+   * \brief Checks a generated trajectory step by step, and cuts it at the
+   * first step that collides.
+   *
+   * The states and inputs from the colliding step on are deleted, and the
+   * list of intermediate vertices is cleared.
+   *
+   * @returns Returns 1 if the trajectory is collision free, 0 otherwise.
+   */
+  int truncate_at_collision(State *state_from_in,
+                            collision_checker_t &collision_checker,
+                            int *exact_connection_out,
+                            trajectory_t *trajectory_out,
+                            std::list<State *> *intermediate_vertices_out) {
+
+    State *state_prev = state_from_in;
+    auto iter_state = trajectory_out->list_states.begin();
+    auto iter_input = trajectory_out->list_inputs.begin();
+    for (; iter_state != trajectory_out->list_states.end();
+         iter_state++, iter_input++) {
+      if (collision_checker.check_collision_step(state_prev, *iter_state) ==
+          1) {
+        state_prev = *iter_state;
+        continue;
+      }
+
+      for (auto iter = iter_state; iter != trajectory_out->list_states.end();
+           iter++)
+        delete *iter;
+      for (auto iter = iter_input; iter != trajectory_out->list_inputs.end();
+           iter++)
+        delete *iter;
+      trajectory_out->list_states.erase(iter_state,
+                                        trajectory_out->list_states.end());
+      trajectory_out->list_inputs.erase(iter_input,
+                                        trajectory_out->list_inputs.end());
+
+      // The intermediate vertices are states of the trajectory.
+      if (intermediate_vertices_out)
+        intermediate_vertices_out->clear();
+
+      if (exact_connection_out)
+        *exact_connection_out = 0;
+
+      return 0;
+    }
+
+    return 1;
+  }
 };
 }
 } // namespace smp
@@ -3,9 +3,7 @@
   definitions.
 
   This file implements the state, input, and extender classes for a
-  d-dimensional double integrator system, where d is a template parameter
-  when appropriate. Currently, the implementation supports only d = 2.
-  The author is working on the case when d > 2.
+  d-dimensional double integrator system, where d is a template parameter.
 
   * Copyright (C) 2018 Sertac Karaman
   *
@@ -27,19 +25,6 @@
 #ifndef _SMP_SYSTEM_DOUBLE_INTEGRATOR_H_
 #define _SMP_SYSTEM_DOUBLE_INTEGRATOR_H_
 
-// TODO: Generalize to multiple dimensions, make these configurable variables
-// (already started in the .h file)
-#define VELOCITY_CONSTRAINT_RANGE 2.0
-#define VELOCITY_CONSTRAINT_RANGE_2 1.0
-#define VELOCITY_CONSTRAINT_MAX 1.0
-#define VELOCITY_CONSTRAINT_MIN -1.0
-#define VELOCITY_CONSTRAINT_SQ 1.0
-//
-#define INPUT_CONSTRAINT_MAX 1.0
-#define INPUT_CONSTRAINT_MIN -1.0
-//
-#define DELTA_T 0.1 // The time interval of integration and node placement
-
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>
@@ -51,15 +36,64 @@
 
 namespace smp {
 
+// Computes the time-optimal bang-coast-bang control of one axis, with the
+// input bounded by u_max and the coasting velocity by v_max, and returns its
+// duration, or a negative number if there is none. If direction is NULL,
+// only the duration is computed, and the other outputs are not written.
 double extend_with_time_optimal_control_one_axis(
-    double s_ini[2], double s_fin[2], double u_max, int *direction,
-    int *traj_saturated, double *x_intersect_beg, double *x_intersect_end,
+    double s_ini[2], double s_fin[2], double u_max, double v_max,
+    int *direction, int *traj_saturated, double *x_intersect_beg,
+    double *x_intersect_end, double *v_intersect);
+
+// Computes the minimum-effort bang-coast-bang control of one axis that
+// arrives at t_goal, in closed form. t_min is the time-optimal duration of
+// the axis, and t_eps the tolerance on t_goal. Returns 1 for success, 0 if
+// the axis cannot arrive at t_goal.
+int extend_with_effort_optimal_control_one_axis(
+    double s_ini[2], double s_fin[2], double u_max, double v_max, double t_min,
+    double t_goal, double t_eps, int *dir, int *traj_saturated,
+    double *max_control, double *x_intersect_beg, double *x_intersect_end,
     double *v_intersect);
 
-int extend_with_effort_optimal_control_one_axis(
-    double s_ini[2], double s_fin[2], double u_max, double t_min, double t_goal,
-    double t_eps, int *dir, int *traj_saturated, double *max_control,
-    double *x_intersect_beg, double *x_intersect_end, double *v_intersect);
+//! Bang-coast-bang control of one axis of a double integrator.
+/*!
+  The axis accelerates with the input direction * control up to t_beg,
+  coasts with the velocity v_c from x_beg to x_end up to t_coast_end, and
+  accelerates with the input -direction * control up to t_end, where it
+  reaches s_fin. The control is first solved for the minimum time, and can
+  then be slowed down to arrive at a later time.
+*/
+struct ControlOneAxis {
+  double s_ini[2];
+  double s_fin[2];
+  int direction;
+  int saturated;
+  double control;
+  double x_beg;
+  double x_end;
+  double v_c;
+  double t_beg;
+  double t_coast_end;
+  double t_end;
+
+  // Solves for the time-optimal control from s_ini to s_fin. Returns its
+  // duration, or a negative number if there is none.
+  double solve_time_optimal(double u_max, double v_max);
+
+  // Slows the control down to the minimum-effort control that arrives at
+  // t_goal, where t_min is the time-optimal duration. Returns 1 for success,
+  // 0 if the axis cannot arrive at t_goal.
+  int synchronize(double u_max, double v_max, double t_min, double t_goal);
+
+  // Computes the position and the velocity at time t.
+  void evaluate(double t, double *x_out, double *v_out) const;
+
+  // Returns the input applied at time t.
+  double input(double t) const;
+
+  // Computes the switching times from the control.
+  void set_timing();
+};
 
 //! Implementation of the state data structure for the double integrator
 //! dynamics
@@ -69,7 +103,8 @@ int extend_with_effort_optimal_control_one_axis(
   positions are stored in the usual order first, and then the all velocities
   are stored in their usual order, in the array.
 */
-class StateDoubleIntegrator : public StateArrayDouble<4> {};
+template <int NUM_DIMENSIONS>
+class StateDoubleIntegrator : public StateArrayDouble<2 * NUM_DIMENSIONS> {};
 
 //! Implementation of the input data structure for the double integrator
 //! dynamics
@@ -78,45 +113,138 @@ class StateDoubleIntegrator : public StateArrayDouble<4> {};
   input variable, placed in the beginning of the array, is used to store the
   time it takes to execute the trajectory segment.
 */
-class InputDoubleIntegrator : public InputArrayDouble<3> {};
+template <int NUM_DIMENSIONS>
+class InputDoubleIntegrator : public InputArrayDouble<1 + NUM_DIMENSIONS> {};
 
 namespace extenders {
 //! Extender function with double integrator dynamics.
-/*! This class implements an extender with double integrator dynamics. It is
-  intended that the number of dimensions of the state space is a template
-  argument for the class. However, this feature is not implemented yet.
-  Currently, the double integrator system works only in two dimensions
-  (NUM_DIMENSIONS = 2), i.e., two positions and their two velocities.
+/*! This class implements an extender with double integrator dynamics. The
+  number of dimensions of the state space is a template argument for the
+  class. Each axis has its own bounds on the velocity and on the input,
+  which can be set at run time.
+
+  Every axis is first solved for its time-optimal bang-coast-bang control.
+  All axes except the slowest one are then slowed down, in closed form, to
+  the minimum-effort control that arrives at the same time as the slowest
+  one, so the duration of the trajectory is the largest of the time-optimal
+  durations of the axes.
 
   \ingroup extenders
 */
+template <int NUM_DIMENSIONS>
 class DoubleIntegrator
-    : public Base<StateDoubleIntegrator, InputDoubleIntegrator> {
-
-  using state_t = StateDoubleIntegrator;
-  using input_t = InputDoubleIntegrator;
-  using trajectory_t = Trajectory<StateDoubleIntegrator, InputDoubleIntegrator>;
-
-  // // TODO: get back to appropriate velocity constraints.
-  // double velocity_constraint_min[NUM_DIMENSIONS];
-  // double velocity_constraint_max[NUM_DIMENSIONS];
-
+    : public Base<StateDoubleIntegrator<NUM_DIMENSIONS>,
+                  InputDoubleIntegrator<NUM_DIMENSIONS>> {
+
+  using state_t = StateDoubleIntegrator<NUM_DIMENSIONS>;
+  using input_t = InputDoubleIntegrator<NUM_DIMENSIONS>;
+  using trajectory_t = Trajectory<state_t, input_t>;
+  using collision_checker_t =
+      typename Base<state_t, input_t>::collision_checker_t;
+
+  // The bounds on the velocity and on the input of every axis.
+  double velocity_max[NUM_DIMENSIONS];
+  double input_max[NUM_DIMENSIONS];
+
+  // The time interval of integration and node placement.
+  double time_step{0.1};
+
+  // Solves every axis, and synchronizes them. Returns the duration of the
+  // trajectory, or a negative number if there is none.
+  double solve(state_t *state_ini, state_t *state_fin,
+               ControlOneAxis *controls_out);
+
+  // Generates the trajectory. If collision_checker_in is not NULL, every
+  // step is checked as soon as it is generated, and the generation stops at
+  // the first step that collides, returning -1.
   int extend_with_optimal_control(
-      StateDoubleIntegrator *state_ini, StateDoubleIntegrator *state_fin,
-      std::list<StateDoubleIntegrator *> *list_states_out,
-      std::list<input_t *> *list_inputs_out);
+      state_t *state_ini, state_t *state_fin,
+      std::list<state_t *> *list_states_out,
+      std::list<input_t *> *list_inputs_out,
+      collision_checker_t *collision_checker_in = NULL);
 
 public:
-  inline DoubleIntegrator() {}
-  inline ~DoubleIntegrator() {}
-
-  inline int
-  extend(StateDoubleIntegrator *state_from_in,
-         StateDoubleIntegrator *state_towards_in, int *exact_connection_out,
-         trajectory_t *trajectory_out,
-         std::list<StateDoubleIntegrator *> *intermediate_vertices_out);
-}; // namespace extenders
+  DoubleIntegrator();
+  ~DoubleIntegrator();
+
+  /**
+   * \brief Sets the bound on the magnitude of the velocity of one axis.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_velocity_max(int axis, double velocity_max_in);
+
+  /**
+   * \brief Sets the bound on the magnitude of the velocity of all axes.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_velocity_max(double velocity_max_in);
+
+  /**
+   * \brief Sets the bound on the magnitude of the input of one axis.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_input_max(int axis, double input_max_in);
+
+  /**
+   * \brief Sets the bound on the magnitude of the input of all axes.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_input_max(double input_max_in);
+
+  /**
+   * \brief Sets the time between consecutive states of the trajectories.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_time_step(double time_step_in);
+
+  int extend(state_t *state_from_in, state_t *state_towards_in,
+             int *exact_connection_out, trajectory_t *trajectory_out,
+             std::list<state_t *> *intermediate_vertices_out);
+
+  int extend_checked(state_t *state_from_in, state_t *state_towards_in,
+                     collision_checker_t &collision_checker,
+                     int *exact_connection_out, trajectory_t *trajectory_out,
+                     std::list<state_t *> *intermediate_vertices_out);
+
+  /**
+   * \brief Returns the duration of the trajectory that extend() generates,
+   * without generating it.
+   *
+   * The duration is the largest of the time-optimal durations of the axes.
+   * The other axes are synchronized to arrive with the slowest one, as in
+   * extend(), and the extension fails if one of them cannot.
+   *
+   * @returns Returns the duration, or a negative number if extend() fails.
+   */
+  double extend_time(state_t *state_from_in, state_t *state_towards_in);
+
+  /**
+   * \brief Returns the largest of the minimum times of the axes.
+   *
+   * All axes must reach their final states at the same time, so the
+   * duration of any trajectory is at least the time-optimal duration of each
+   * axis, computed without the other axes.
+   */
+  double cost_lower_bound(state_t *state_from_in, state_t *state_towards_in);
+
+  /**
+   * \brief Returns the duration of the trajectory that extend() generates,
+   * see extend_time().
+   *
+   * If extend() fails, the bound is DBL_MAX, so that the planner never ranks
+   * the extension ahead of one that it can generate.
+   */
+  double cost_extend_lower_bound(state_t *state_from_in,
+                                 state_t *state_towards_in);
+};
 } // namespace extenders
 } // namespace smp
 
+#include <smp/extenders/double_integrator_impl.hpp>
+
 #endif
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2018 Sertac Karaman
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#ifndef _SMP_SYSTEM_DOUBLE_INTEGRATOR_HPP_
+#define _SMP_SYSTEM_DOUBLE_INTEGRATOR_HPP_
+
+template <int NUM_DIMENSIONS>
+smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::DoubleIntegrator() {
+
+  for (int axis = 0; axis < NUM_DIMENSIONS; axis++) {
+    velocity_max[axis] = 1.0;
+    input_max[axis] = 1.0;
+  }
+}
+
+template <int NUM_DIMENSIONS>
+smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::~DoubleIntegrator() {}
+
+template <int NUM_DIMENSIONS>
+int smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::set_velocity_max(
+    int axis, double velocity_max_in) {
+
+  if ((axis < 0) || (axis >= NUM_DIMENSIONS) || !(velocity_max_in > 0.0))
+    return 0;
+
+  velocity_max[axis] = velocity_max_in;
+
+  return 1;
+}
+
+template <int NUM_DIMENSIONS>
+int smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::set_velocity_max(
+    double velocity_max_in) {
+
+  if (!(velocity_max_in > 0.0))
+    return 0;
+
+  for (int axis = 0; axis < NUM_DIMENSIONS; axis++)
+    velocity_max[axis] = velocity_max_in;
+
+  return 1;
+}
+
+template <int NUM_DIMENSIONS>
+int smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::set_input_max(
+    int axis, double input_max_in) {
+
+  if ((axis < 0) || (axis >= NUM_DIMENSIONS) || !(input_max_in > 0.0))
+    return 0;
+
+  input_max[axis] = input_max_in;
+
+  return 1;
+}
+
+template <int NUM_DIMENSIONS>
+int smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::set_input_max(
+    double input_max_in) {
+
+  if (!(input_max_in > 0.0))
+    return 0;
+
+  for (int axis = 0; axis < NUM_DIMENSIONS; axis++)
+    input_max[axis] = input_max_in;
+
+  return 1;
+}
+
+template <int NUM_DIMENSIONS>
+int smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::set_time_step(
+    double time_step_in) {
+
+  if (!(time_step_in > 0.0))
+    return 0;
+
+  time_step = time_step_in;
+
+  return 1;
+}
+
+template <int NUM_DIMENSIONS>
+double smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::solve(
+    state_t *state_ini, state_t *state_fin, ControlOneAxis *controls_out) {
+
+  // 1. Compute the time-optimal control of every axis
+  double times[NUM_DIMENSIONS];
+  double time_max = 0.0;
+  for (int axis = 0; axis < NUM_DIMENSIONS; axis++) {
+    ControlOneAxis &control = controls_out[axis];
+    control.s_ini[0] = (*state_ini)[axis];
+    control.s_ini[1] = (*state_ini)[axis + NUM_DIMENSIONS];
+    control.s_fin[0] = (*state_fin)[axis];
+    control.s_fin[1] = (*state_fin)[axis + NUM_DIMENSIONS];
+
+    times[axis] =
+        control.solve_time_optimal(input_max[axis], velocity_max[axis]);
+    if (times[axis] < 0.0)
+      return -1.0;
+    if (times[axis] > time_max)
+      time_max = times[axis];
+  }
+
+  // 2. Compute the minimum effort control for the other axes, so that they
+  //    arrive with the slowest one
+  for (int axis = 0; axis < NUM_DIMENSIONS; axis++)
+    if ((times[axis] < time_max) &&
+        !controls_out[axis].synchronize(input_max[axis], velocity_max[axis],
+                                        times[axis], time_max))
+      return -1.0;
+
+  return time_max;
+}
+
+template <int NUM_DIMENSIONS>
+int smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::
+    extend_with_optimal_control(state_t *state_ini, state_t *state_fin,
+                                std::list<state_t *> *list_states_out,
+                                std::list<input_t *> *list_inputs_out,
+                                collision_checker_t *collision_checker_in) {
+
+  list_states_out->clear();
+  list_inputs_out->clear();
+
+  ControlOneAxis controls[NUM_DIMENSIONS];
+  double time_end = solve(state_ini, state_fin, controls);
+  if (!(time_end > 0.0))
+    return 0;
+
+  // The state that the next step starts from.
+  state_t *state_prev = state_ini;
+
+  double t_curr = 0.0;
+  while (t_curr < time_end) {
+
+    // Determine the current time to act. Steps end at every switching time
+    // of the axes, however close to the last step, so that the inputs are
+    // constant along every step.
+    double t_next = t_curr + time_step;
+    for (int axis = 0; axis < NUM_DIMENSIONS; axis++) {
+      const ControlOneAxis &control = controls[axis];
+      if ((control.t_beg > t_curr) && (control.t_beg < t_next))
+        t_next = control.t_beg;
+      if ((control.t_coast_end > t_curr) && (control.t_coast_end < t_next))
+        t_next = control.t_coast_end;
+    }
+    if (t_next > time_end)
+      t_next = time_end;
+
+    // Calculate the states/inputs at the current time
+    state_t *state_new = new state_t;
+    input_t *input_new = new input_t;
+
+    double t_mid = (t_curr + t_next) / 2.0;
+    for (int axis = 0; axis < NUM_DIMENSIONS; axis++) {
+      controls[axis].evaluate(t_next, &(*state_new)[axis],
+                              &(*state_new)[axis + NUM_DIMENSIONS]);
+      (*input_new)[1 + axis] = controls[axis].input(t_mid);
+    }
+    (*input_new)[0] = t_next - t_curr;
+
+    // The last state is the final state, up to the rounding of the timing.
+    if (t_next >= time_end)
+      *state_new = *state_fin;
+
+    // Stop at the first step that collides
+    if (collision_checker_in &&
+        (collision_checker_in->check_collision_step(state_prev, state_new) !=
+         1)) {
+      delete state_new;
+      delete input_new;
+      return -1;
+    }
+    state_prev = state_new;
+
+    // Store the states/inputs to the list
+    list_states_out->push_back(state_new);
+    list_inputs_out->push_back(input_new);
+
+    t_curr = t_next;
+  }
+
+  return 1;
+}
+
+template <int NUM_DIMENSIONS>
+int smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::extend(
+    state_t *state_from_in, state_t *state_towards_in,
+    int *exact_connection_out, trajectory_t *trajectory_out,
+    std::list<state_t *> *intermediate_vertices_out) {
+
+  if (exact_connection_out)
+    *exact_connection_out = 0;
+  if (intermediate_vertices_out)
+    intermediate_vertices_out->clear();
+  if (extend_with_optimal_control(state_from_in, state_towards_in,
+                                  &(trajectory_out->list_states),
+                                  &(trajectory_out->list_inputs)) != 1)
+    return 0;
+  if (exact_connection_out)
+    *exact_connection_out = 1;
+  return 1;
+}
+
+template <int NUM_DIMENSIONS>
+int smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::extend_checked(
+    state_t *state_from_in, state_t *state_towards_in,
+    collision_checker_t &collision_checker, int *exact_connection_out,
+    trajectory_t *trajectory_out,
+    std::list<state_t *> *intermediate_vertices_out) {
+
+  if (exact_connection_out)
+    *exact_connection_out = 0;
+  if (intermediate_vertices_out)
+    intermediate_vertices_out->clear();
+  int result = extend_with_optimal_control(
+      state_from_in, state_towards_in, &(trajectory_out->list_states),
+      &(trajectory_out->list_inputs), &collision_checker);
+  if (result == 0)
+    return -1;
+
+  // The trajectory holds the steps before the collision.
+  if (result < 0)
+    return 0;
+
+  if (exact_connection_out)
+    *exact_connection_out = 1;
+  return 1;
+}
+
+template <int NUM_DIMENSIONS>
+double smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::extend_time(
+    state_t *state_from_in, state_t *state_towards_in) {
+
+  ControlOneAxis controls[NUM_DIMENSIONS];
+  double time_end = solve(state_from_in, state_towards_in, controls);
+
+  return (time_end > 0.0) ? time_end : -1.0;
+}
+
+template <int NUM_DIMENSIONS>
+double smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::cost_lower_bound(
+    state_t *state_from_in, state_t *state_towards_in) {
+
+  double time_max = 0.0;
+  for (int axis = 0; axis < NUM_DIMENSIONS; axis++) {
+    double s_ini[2] = {(*state_from_in)[axis],
+                       (*state_from_in)[axis + NUM_DIMENSIONS]};
+    double s_fin[2] = {(*state_towards_in)[axis],
+                       (*state_towards_in)[axis + NUM_DIMENSIONS]};
+    double time = extend_with_time_optimal_control_one_axis(
+        s_ini, s_fin, input_max[axis], velocity_max[axis], NULL, NULL, NULL,
+        NULL, NULL);
+    if (time > time_max)
+      time_max = time;
+  }
+
+  return time_max;
+}
+
+template <int NUM_DIMENSIONS>
+double
+smp::extenders::DoubleIntegrator<NUM_DIMENSIONS>::cost_extend_lower_bound(
+    state_t *state_from_in, state_t *state_towards_in) {
+
+  double time = extend_time(state_from_in, state_towards_in);
+
+  return (time > 0.0) ? time : DBL_MAX;
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include <smp/state_array_double.hpp>
 
 #include <list>
+#include <vector>
 
 namespace smp {
 
@@ -55,9 +56,64 @@ class StateDubins : public StateArrayDouble<3> {};
 */
 class InputDubins : public InputArrayDouble<2> {};
 
+//! Analytic description of a Dubins path.
+/*!
+  A Dubins path is a sequence of three segments, each of which is a left
+  turn, a right turn or a straight line. The path is described by its word,
+  i.e., the types of its segments, and by the lengths of the segments, so
+  that its cost is known without generating the states along it.
+
+  \ingroup extenders
+*/
+class PathDubins {
+public:
+  //! The word of the path, in the order LSL, RSR, LSR, RSL, RLR and LRL, or
+  //! -1 if there is no path.
+  int word{-1};
+
+  //! The lengths of the three segments.
+  double lengths[3]{0.0, 0.0, 0.0};
+
+  //! The turning radius of the turns.
+  double turning_radius{1.0};
+
+  inline double get_length() const {
+    return lengths[0] + lengths[1] + lengths[2];
+  }
+
+  /**
+   * \brief Computes the pose at a distance along the path.
+   *
+   * The pose is computed from the initial pose of the segment that the
+   * distance falls in, so the errors do not accumulate along the path. A
+   * distance at the end of a segment falls in that segment.
+   *
+   * @param state_from_in The state that the path starts from.
+   * @param distance The distance along the path, clamped to its length.
+   * @param x_out, y_out, t_out The position and the heading, in [0, 2 pi).
+   */
+  void evaluate(StateDubins *state_from_in, double distance, double *x_out,
+                double *y_out, double *t_out) const;
+
+  /**
+   * \brief Returns the direction of the segment at a distance along the
+   * path, 1 for a left turn, -1 for a right turn and 0 for a straight
+   * segment.
+   */
+  int get_direction(double distance) const;
+};
+
 //! Implements the extender function with Dubins car dynamics.
 /*!
-  This class implements an extender with the Dubins car dynamics.
+  This class implements an extender with the Dubins car dynamics. The
+  extension is the shortest of the six Dubins paths, LSL, RSR, LSR, RSL, RLR
+  and LRL, whose segment lengths are computed in closed form.
+
+  The path is found by solve(), which only computes its description, and its
+  states are generated by materialize(). The planner asks for the cost of a
+  candidate extension with cost_extend_lower_bound(), which solves the path,
+  and only extends the candidates that may improve the tree. The last path
+  solved is kept, so that extend() does not solve it again.
 
   \ingroup extenders
 */
@@ -69,26 +125,179 @@ class Dubins : public Base<StateDubins, InputDubins> {
 
   double turning_radius{1.0};
 
-  int extend_dubins_spheres(double x_s1, double y_s1, double t_s1, double x_s2,
-                            double y_s2, double t_s2, int comb_no,
-                            int *fully_extends,
-                            std::list<StateDubins *> *list_states,
-                            std::list<InputDubins *> *list_inputs);
+  // Length of the trajectory between consecutive states generated by
+  // extend().
+  double step{0.25};
+
+  // The last path solved, and its states.
+  PathDubins path_last;
+  StateDubins state_from_last;
+  StateDubins state_towards_last;
 
-  double extend_dubins_all(StateDubins *state_ini, StateDubins *state_fin,
-                           int *fully_extends,
-                           std::list<StateDubins *> *list_states_out,
-                           std::list<InputDubins *> *list_inputs_out);
+  // Solves for the lengths of the segments of all six path words, in units
+  // of the turning radius, and returns the index of the shortest word or -1
+  // if there is none.
+  int solve_dubins(StateDubins *state_ini, StateDubins *state_fin,
+                   double *lengths_out);
+
+  // Scratch buffers for the positions and headings of a batch of states.
+  std::vector<double> batch_x;
+  std::vector<double> batch_y;
+  std::vector<double> batch_t;
+
+  // Computes the lengths of the shortest paths between one state and a batch
+  // of states, from the state if from_state is true and to it otherwise.
+  int lengths_batch(StateDubins *state_in, bool from_state, int num_states,
+                    const double *x_in, const double *y_in,
+                    const double *t_in, const double *lengths_max_in,
+                    double *lengths_out);
+
+  // Copies the positions and headings of a batch of states to the scratch
+  // buffers.
+  void gather_batch(StateDubins **states_in, int num_states);
 
 public:
   Dubins();
   ~Dubins();
 
-  inline void set_turning_radius(double radius) { turning_radius = radius; }
+  inline void set_turning_radius(double radius) {
+    turning_radius = radius;
+    path_last.word = -1;
+  }
+
+  /**
+   * \brief Sets the length of the trajectory between consecutive states
+   * generated by extend().
+   *
+   * The states are the ones checked by the collision checker, so the step
+   * should be small enough for the checker not to miss obstacles between
+   * them.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  inline int set_step(double step_in) {
+    if (!(step_in > 0.0))
+      return 0;
+    step = step_in;
+    return 1;
+  }
+
+  /**
+   * \brief Returns the length of the trajectory between consecutive states
+   * generated by extend().
+   */
+  inline double get_step() const { return step; }
+
+  /**
+   * \brief Computes the description of the shortest path between two
+   * states, without generating its states.
+   *
+   * @param state_from_in The state that the path starts from.
+   * @param state_towards_in The state that the path reaches.
+   * @param path_out The description of the path.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int solve(StateDubins *state_from_in, StateDubins *state_towards_in,
+            PathDubins *path_out);
+
+  /**
+   * \brief Generates the states and inputs along a path.
+   *
+   * A state is generated every step along every segment, and at the end of
+   * every segment. The trajectory is truncated if it is longer than the
+   * distance limit, in which case the connection is not exact.
+   *
+   * @param state_from_in The state that the path starts from.
+   * @param state_towards_in The state that the path reaches.
+   * @param path_in The description of the path, as computed by solve().
+   * @param step_in The length of the path between consecutive states.
+   * @param exact_connection_out Set to one if the trajectory reaches
+   *                             state_towards_in, zero otherwise.
+   * @param trajectory_out The trajectory that the states and inputs are
+   *                       appended to.
+   * @param collision_checker_in If not NULL, every step is checked as soon
+   *                             as it is generated, and the generation stops
+   *                             at the first step that collides.
+   *
+   * @returns Returns 1 for success, 0 if a step collides, and a negative
+   * number for failure.
+   */
+  int materialize(StateDubins *state_from_in, StateDubins *state_towards_in,
+                  const PathDubins &path_in, double step_in,
+                  int *exact_connection_out, TrajectoryDubins *trajectory_out,
+                  collision_checker_t *collision_checker_in = NULL);
+
+  /**
+   * \brief Computes the lengths of the shortest paths from a state to a
+   * batch of states.
+   *
+   * The batch is given as arrays of the positions and the headings of its
+   * states. The work that only depends on state_from_in is done once, and a
+   * bound that takes no trigonometric function is computed for every state
+   * before its path is solved. If lengths_max_in is not NULL, the paths whose
+   * bound is not shorter than lengths_max_in are not solved, and their
+   * lengths are replaced by the bound.
+   *
+   * @param state_from_in The state that the paths start from.
+   * @param num_states The number of states in the batch.
+   * @param x_in, y_in, t_in The positions and headings of the states.
+   * @param lengths_max_in The lengths above which the paths need not be
+   *                       solved, or NULL.
+   * @param lengths_out The lengths of the paths, or lower bounds on the
+   *                    lengths that are not shorter than lengths_max_in.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int lengths_from(StateDubins *state_from_in, int num_states,
+                   const double *x_in, const double *y_in, const double *t_in,
+                   const double *lengths_max_in, double *lengths_out);
+
+  /**
+   * \brief Computes the lengths of the shortest paths from a batch of
+   * states to a state.
+   *
+   * See lengths_from() for the arguments.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int lengths_to(StateDubins *state_towards_in, int num_states,
+                 const double *x_in, const double *y_in, const double *t_in,
+                 const double *lengths_max_in, double *lengths_out);
 
   int extend(StateDubins *state_from_in, StateDubins *state_towards_in,
              int *exact_connection_out, TrajectoryDubins *trajectory_out,
              std::list<StateDubins *> *intermediate_vertices_out);
+
+  int extend_checked(StateDubins *state_from_in, StateDubins *state_towards_in,
+                     collision_checker_t &collision_checker,
+                     int *exact_connection_out,
+                     TrajectoryDubins *trajectory_out,
+                     std::list<StateDubins *> *intermediate_vertices_out);
+
+  /**
+   * \brief Returns the Euclidean distance between the positions of the
+   * states, which bounds the length of any path between them.
+   */
+  double cost_lower_bound(StateDubins *state_from_in,
+                          StateDubins *state_towards_in);
+
+  /**
+   * \brief Returns the length of the shortest path between the states,
+   * which is the cost of the trajectory generated by extend().
+   */
+  double cost_extend_lower_bound(StateDubins *state_from_in,
+                                 StateDubins *state_towards_in);
+
+  int cost_extend_lower_bounds_from(StateDubins *state_from_in,
+                                    StateDubins **states_towards_in,
+                                    int num_states, const double *costs_max_in,
+                                    double *bounds_out);
+
+  int cost_extend_lower_bounds_to(StateDubins **states_from_in,
+                                  StateDubins *state_towards_in,
+                                  int num_states, const double *costs_max_in,
+                                  double *bounds_out);
 };
 } // namespace extenders
 } // namespace smp
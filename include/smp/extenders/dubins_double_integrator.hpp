@@ -0,0 +1,216 @@
+/*! \file components/extenders/dubins_double_integrator.h
+  \brief The Dubins double integrator system components. State, input, and
+  extender definitions.
+
+  This file implements the state, input, and extender classes for an
+  airplane that moves as a Dubins car in the horizontal plane, and as a
+  double integrator in altitude.
+
+  * Copyright (C) 2018 Sertac Karaman
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#ifndef _SMP_SYSTEM_DUBINS_DOUBLE_INTEGRATOR_H_
+#define _SMP_SYSTEM_DUBINS_DOUBLE_INTEGRATOR_H_
+
+#include <smp/extenders/base.hpp>
+#include <smp/extenders/double_integrator.hpp>
+#include <smp/extenders/dubins.hpp>
+#include <smp/input_array_double.hpp>
+#include <smp/state_array_double.hpp>
+
+#include <list>
+#include <vector>
+
+namespace smp {
+
+//! State data structure for the Dubins double integrator airplane dynamics
+/*!
+  This class implements the state data structure for the Dubins double
+  integrator dynamics. The number of state variables is five. The state
+  variables are the position in the x, y and z coordinates, the heading, and
+  the vertical velocity, in this order.
+
+  \ingroup states
+*/
+class StateDubinsDoubleIntegrator : public StateArrayDouble<5> {};
+
+//! Input data structure for the Dubins double integrator airplane dynamics
+/*!
+  This class implements the input data structure for the Dubins double
+  integrator dynamics. The number of input variables is three. The first
+  input variable stores the time it takes to execute the trajectory segment,
+  the second one the steering input, and the third one the vertical
+  acceleration.
+
+  \ingroup inputs
+*/
+class InputDubinsDoubleIntegrator : public InputArrayDouble<3> {};
+
+namespace extenders {
+
+//! Extender function with Dubins double integrator airplane dynamics.
+/*!
+  This class implements an extender for an airplane that flies with a
+  constant horizontal speed along the shortest Dubins path between the
+  projections of the states on the horizontal plane, and whose altitude is a
+  double integrator with bounds on the vertical velocity and acceleration.
+
+  The duration of the trajectory is the length of the Dubins path divided by
+  the speed. The altitude is first solved for its time-optimal
+  bang-coast-bang control, and then slowed down to the minimum-effort control
+  that arrives at the end of the Dubins path. The extension fails if the
+  altitude cannot change within that time.
+
+  \ingroup extenders
+*/
+class DubinsDoubleIntegrator
+    : public Base<StateDubinsDoubleIntegrator, InputDubinsDoubleIntegrator> {
+
+  using state_t = StateDubinsDoubleIntegrator;
+  using input_t = InputDubinsDoubleIntegrator;
+  using trajectory_t = Trajectory<state_t, input_t>;
+
+  // Solves the paths in the horizontal plane, and keeps the last one.
+  Dubins dubins;
+
+  // The horizontal speed.
+  double speed{1.0};
+
+  // The bounds on the vertical velocity and on the vertical acceleration.
+  double velocity_max{1.0};
+  double input_max{1.0};
+
+  // The time interval of integration and node placement.
+  double time_step{0.2};
+
+  // Scratch buffers for the horizontal poses and the length bounds of a
+  // batch of states.
+  std::vector<double> batch_x;
+  std::vector<double> batch_y;
+  std::vector<double> batch_t;
+  std::vector<double> batch_lengths_max;
+
+  // Solves the horizontal path and the altitude control. Returns the
+  // duration of the trajectory, or a negative number if there is none.
+  double solve(state_t *state_ini, state_t *state_fin, PathDubins *path_out,
+               ControlOneAxis *altitude_out);
+
+  // Generates the trajectory. If collision_checker_in is not NULL, every
+  // step is checked as soon as it is generated, and the generation stops at
+  // the first step that collides, returning -1.
+  int extend_with_optimal_control(
+      state_t *state_ini, state_t *state_fin, trajectory_t *trajectory_out,
+      collision_checker_t *collision_checker_in = NULL);
+
+  // Computes the bounds of a batch, from the state if from_state is true
+  // and to it otherwise.
+  int cost_extend_lower_bounds_batch(state_t *state_in, bool from_state,
+                                     state_t **states_in, int num_states,
+                                     const double *costs_max_in,
+                                     double *bounds_out);
+
+public:
+  DubinsDoubleIntegrator();
+  ~DubinsDoubleIntegrator();
+
+  /**
+   * \brief Sets the turning radius of the horizontal paths.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_turning_radius(double turning_radius_in);
+
+  /**
+   * \brief Sets the horizontal speed.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_speed(double speed_in);
+
+  /**
+   * \brief Sets the bound on the magnitude of the vertical velocity.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_velocity_max(double velocity_max_in);
+
+  /**
+   * \brief Sets the bound on the magnitude of the vertical acceleration.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_input_max(double input_max_in);
+
+  /**
+   * \brief Sets the time between consecutive states of the trajectories.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_time_step(double time_step_in);
+
+  int extend(state_t *state_from_in, state_t *state_towards_in,
+             int *exact_connection_out, trajectory_t *trajectory_out,
+             std::list<state_t *> *intermediate_vertices_out);
+
+  int extend_checked(state_t *state_from_in, state_t *state_towards_in,
+                     collision_checker_t &collision_checker,
+                     int *exact_connection_out, trajectory_t *trajectory_out,
+                     std::list<state_t *> *intermediate_vertices_out);
+
+  /**
+   * \brief Returns the duration of the trajectory that extend() generates,
+   * without generating it.
+   *
+   * @returns Returns the duration, or a negative number if there is no
+   * trajectory.
+   */
+  double extend_time(state_t *state_from_in, state_t *state_towards_in);
+
+  /**
+   * \brief Returns the larger of the time it takes to fly straight between
+   * the horizontal positions, and the minimum time of the altitude change.
+   */
+  double cost_lower_bound(state_t *state_from_in, state_t *state_towards_in);
+
+  /**
+   * \brief Returns the duration of the trajectory that extend() generates,
+   * see extend_time(), or cost_lower_bound() if there is none.
+   */
+  double cost_extend_lower_bound(state_t *state_from_in,
+                                 state_t *state_towards_in);
+
+  /**
+   * \brief Computes the durations of the Dubins paths from a state to a
+   * batch of states.
+   *
+   * The bounds do not account for the altitude, so they are not larger than
+   * the ones of cost_extend_lower_bound().
+   */
+  int cost_extend_lower_bounds_from(state_t *state_from_in,
+                                    state_t **states_towards_in,
+                                    int num_states, const double *costs_max_in,
+                                    double *bounds_out);
+
+  int cost_extend_lower_bounds_to(state_t **states_from_in,
+                                  state_t *state_towards_in, int num_states,
+                                  const double *costs_max_in,
+                                  double *bounds_out);
+};
+} // namespace extenders
+} // namespace smp
+
+#endif
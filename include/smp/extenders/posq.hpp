@@ -11,6 +11,7 @@
 #include <smp/input_array_double.hpp>
 #include <smp/state_array_double.hpp>
 #include <smp/trajectory.hpp>
+#include <vector>
 
 namespace smp {
 
@@ -43,7 +44,24 @@ class PosQ : public Base<StatePosQ, InputPosQ> {
 
   using trajectory_t = Trajectory<StatePosQ, InputPosQ>;
 
-  /** This function will generate a vector of double as output:
+  // Gains of the controller, and the bound on the wheel velocities.
+  double gain_rho{1.0};
+  double gain_alpha{3.0};
+  double gain_beta{-1.0};
+  double velocity_max{1.0};
+
+  // Distance between the wheels.
+  double wheel_base{0.4};
+
+  // Number of controller steps after which a rollout is abandoned.
+  int steps_max{1000};
+
+  double set_angle_to_range(double alpha, double min) const;
+  double diff_angle_unwrap(double alpha1, double alpha2) const;
+
+  double f(double rho) const;
+
+  /** Computes one step of the controller, and writes to result_out:
 
    *  [0] Vl velocity of the left wheel;
    *  [1] Vr velocity of the right wheel;
@@ -51,26 +69,96 @@ class PosQ : public Base<StatePosQ, InputPosQ> {
    *  [3] W Angular Velocity.
    *  [4] EOT End Of Trajectory
 
-  **/
-
-  double set_angle_to_range(double alpha, double min);
-  double diff_angle_unwrap(double alpha1, double alpha2);
-
-  double f(double rho);
+   *  beta_inout holds the angle beta of the previous step, and is updated.
 
-  double *posctrlstep(double x_c, double y_c, double t_c, double x_end,
-                      double y_end, double t_end, double ct, double b, int dir);
+  **/
+  void posctrlstep(double x_c, double y_c, double t_c, double x_end,
+                   double y_end, double t_end, double b, int dir,
+                   double *beta_inout, double *result_out) const;
 
-  double posctrl(StatePosQ *state_ini, StatePosQ *state_fin, int dir, double b,
-                 double dt, std::list<StatePosQ *> *list_states_out,
-                 std::list<InputPosQ *> *list_inputs_out);
+  double normangle(double a, double mina) const;
 
-  double normangle(double a, double mina);
+  // Runs the controller with an optional collision checker, and copies the
+  // rollout to the trajectory. Returns 1 for an exact connection, 0 if the
+  // rollout misses the goal, and -1 if it collides.
+  int extend_rollout(StatePosQ *state_from_in, StatePosQ *state_towards_in,
+                     collision_checker_t *collision_checker_in,
+                     int *exact_connection_out, trajectory_t *trajectory_out,
+                     std::list<StatePosQ *> *intermediate_vertices_out);
 
 public:
   PosQ();
   ~PosQ();
 
+  /**
+   * \brief Sets the gains of the controller.
+   *
+   * @param gain_rho_in The gain on the distance to the goal, Krho.
+   * @param gain_alpha_in The gain on the bearing of the goal, Kalpha.
+   * @param gain_beta_in The gain on the angle between the bearing and the
+   *                     heading of the goal, Kbeta.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_gains(double gain_rho_in, double gain_alpha_in, double gain_beta_in);
+
+  /**
+   * \brief Sets the bound on the velocities of the wheels, Vmax.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_velocity_max(double velocity_max_in);
+
+  /**
+   * \brief Returns the largest distance that the robot moves in one step of
+   * the controller, Vmax times the time step.
+   */
+  double get_step_max() const;
+
+  /**
+   * \brief Sets the distance between the wheels.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_wheel_base(double wheel_base_in);
+
+  /**
+   * \brief Sets the number of controller steps after which a rollout that
+   * has not reached its goal is abandoned.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_steps_max(int steps_max_in);
+
+  /**
+   * \brief Simulates the controller from one state towards another.
+   *
+   * The controller state is kept on the stack, so the function can be
+   * called concurrently, on one or on many instances. The states and inputs
+   * are written to the storage provided by the caller, which is cleared
+   * first, so that the storage can be reused without allocating.
+   *
+   * @param state_from_in The state that the rollout starts from.
+   * @param state_towards_in The goal of the controller.
+   * @param dir The direction of motion, 1 forwards, -1 backwards and 0 for
+   *            the direction that faces the goal.
+   * @param states_out The states of the rollout.
+   * @param inputs_out The inputs of the rollout, one for every state.
+   * @param distance_out The distance between the position of the last state
+   *                     and the goal.
+   * @param collision_checker_in If not NULL, every step is checked as soon
+   *                             as it is simulated, and the rollout stops at
+   *                             the first step that collides.
+   *
+   * @returns Returns 1 if the controller reaches its end condition, 0 if the
+   * rollout is abandoned after the maximum number of steps, and -1 if a step
+   * collides, in which case the outputs hold the steps before it.
+   */
+  int rollout(StatePosQ *state_from_in, StatePosQ *state_towards_in, int dir,
+              std::vector<StatePosQ> *states_out,
+              std::vector<InputPosQ> *inputs_out, double *distance_out,
+              collision_checker_t *collision_checker_in = NULL) const;
+
   /**
    * Generates a trajectory, returned in the trajectory_out argument, that
    * connects two given states, provided with the state_from_in and
@@ -95,13 +183,22 @@ public:
              int *exact_connection_out, trajectory_t *trajectory_out,
              std::list<StatePosQ *> *intermediate_vertices_out);
 
-  /// Result for each iteration in posctrlstep
-  double *result;
-  /// Saving the posctrlstep results in this during posctrl procedure
-  double *intRes;
+  int extend_checked(StatePosQ *state_from_in, StatePosQ *state_towards_in,
+                     collision_checker_t &collision_checker,
+                     int *exact_connection_out, trajectory_t *trajectory_out,
+                     std::list<StatePosQ *> *intermediate_vertices_out);
 
-  double T;
-  double xi, yi;
+  /**
+   * \brief Returns a lower bound on the sum of the translational velocities
+   * along a trajectory between the states.
+   *
+   * The robot never moves farther than the commanded translational velocity
+   * times the time step in one step, so the sum of the velocities is at
+   * least the Euclidean distance between the positions divided by the time
+   * step.
+   */
+  double cost_lower_bound(StatePosQ *state_from_in,
+                          StatePosQ *state_towards_in);
 };
 
 } // namespace extenders
@@ -0,0 +1,256 @@
+/*! \file components/extenders/reeds_shepp.h
+  \brief The extend function component that implements a Reeds-Shepp car.
+
+  The extender that this file implements connects two given states with the
+  shortest path of a car that drives forwards and backwards with a minimum
+  turning radius, as described by Reeds and Shepp in the paper Optimal Paths
+  for a Car that Goes both Forwards and Backwards.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#ifndef _SMP_SYSTEM_REEDS_SHEPP_H_
+#define _SMP_SYSTEM_REEDS_SHEPP_H_
+
+#include <smp/extenders/base.hpp>
+#include <smp/input_array_double.hpp>
+#include <smp/state_array_double.hpp>
+
+#include <list>
+#include <vector>
+
+namespace smp {
+
+//! Implementation of the state data structure for the Reeds-Shepp car.
+/*!
+  The number of state variables is three. The state variables indicate
+  position in the x and y coordinates and the orientation, in this order.
+
+  \ingroup states
+*/
+class StateReedsShepp : public StateArrayDouble<3> {};
+
+//! Implementation of the input data structure for the Reeds-Shepp car.
+/*!
+  The number of input variables is exactly three. The first input variable
+  stores the length of the trajectory segment, which is its duration at unit
+  speed. The second variable stores the steering input, -1 for a left turn,
+  1 for a right turn and 0 for a straight segment, as for the Dubins car. The
+  third variable stores the direction of motion, 1 forwards and -1 backwards.
+
+  \ingroup inputs
+*/
+class InputReedsShepp : public InputArrayDouble<3> {};
+
+//! Analytic description of a Reeds-Shepp path.
+/*!
+  A Reeds-Shepp path is a sequence of at most five segments, each of which
+  is a left turn, a right turn or a straight line, driven forwards or
+  backwards. The path is described by its type, i.e., the kinds of its
+  segments, and by the signed lengths of the segments, negative when the car
+  drives backwards.
+
+  \ingroup extenders
+*/
+class PathReedsShepp {
+public:
+  //! The index of the type of the path, or -1 if there is no path.
+  int type{-1};
+
+  //! The signed lengths of the five segments, zero for unused segments.
+  double lengths[5]{0.0, 0.0, 0.0, 0.0, 0.0};
+
+  //! The turning radius of the turns.
+  double turning_radius{1.0};
+
+  inline double get_length() const {
+    double length = 0.0;
+    for (int j = 0; j < 5; j++)
+      length += (lengths[j] < 0.0) ? -lengths[j] : lengths[j];
+    return length;
+  }
+};
+
+//! Implements the extender function with Reeds-Shepp car dynamics.
+/*!
+  This class implements an extender with the Reeds-Shepp car dynamics. The
+  extension is the shortest Reeds-Shepp path, which is found among the nine
+  families of Reeds and Shepp, each with its time-flipped and reflected
+  variants, with closed-form segment lengths. The cost of a trajectory is
+  its length, whether it is driven forwards or backwards.
+
+  The extender has the same interface as extenders::Dubins: solve() computes
+  the description of the path, materialize() generates its states, and the
+  batch functions compute the lengths between one state and many states.
+  The Reeds-Shepp length is symmetric, so the lengths from a batch of states
+  to a state are the lengths from that state to the batch.
+
+  \ingroup extenders
+*/
+
+namespace extenders {
+class ReedsShepp : public Base<StateReedsShepp, InputReedsShepp> {
+
+  using TrajectoryReedsShepp = Trajectory<StateReedsShepp, InputReedsShepp>;
+
+  double turning_radius{1.0};
+
+  // Length of the trajectory between consecutive states generated by
+  // extend().
+  double step{0.25};
+
+  // The last path solved, and its states.
+  PathReedsShepp path_last;
+  StateReedsShepp state_from_last;
+  StateReedsShepp state_towards_last;
+
+  // Scratch buffers for the positions and headings of a batch of states.
+  std::vector<double> batch_x;
+  std::vector<double> batch_y;
+  std::vector<double> batch_t;
+
+  // Copies the positions and headings of a batch of states to the scratch
+  // buffers.
+  void gather_batch(StateReedsShepp **states_in, int num_states);
+
+public:
+  ReedsShepp();
+  ~ReedsShepp();
+
+  inline void set_turning_radius(double radius) {
+    turning_radius = radius;
+    path_last.type = -1;
+  }
+
+  /**
+   * \brief Sets the length of the trajectory between consecutive states
+   * generated by extend().
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  inline int set_step(double step_in) {
+    if (!(step_in > 0.0))
+      return 0;
+    step = step_in;
+    return 1;
+  }
+
+  /**
+   * \brief Computes the description of the shortest path between two
+   * states, without generating its states.
+   *
+   * @param state_from_in The state that the path starts from.
+   * @param state_towards_in The state that the path reaches.
+   * @param path_out The description of the path.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int solve(StateReedsShepp *state_from_in, StateReedsShepp *state_towards_in,
+            PathReedsShepp *path_out);
+
+  /**
+   * \brief Generates the states and inputs along a path.
+   *
+   * A state is generated every step along every segment, and at the end of
+   * every segment.
+   *
+   * @param state_from_in The state that the path starts from.
+   * @param state_towards_in The state that the path reaches.
+   * @param path_in The description of the path, as computed by solve().
+   * @param step_in The length of the path between consecutive states.
+   * @param exact_connection_out Set to one if the trajectory reaches
+   *                             state_towards_in, zero otherwise.
+   * @param trajectory_out The trajectory that the states and inputs are
+   *                       appended to.
+   * @param collision_checker_in If not NULL, every step is checked as soon
+   *                             as it is generated, and the generation stops
+   *                             at the first step that collides.
+   *
+   * @returns Returns 1 for success, 0 if a step collides, and a negative
+   * number for failure.
+   */
+  int materialize(StateReedsShepp *state_from_in,
+                  StateReedsShepp *state_towards_in,
+                  const PathReedsShepp &path_in, double step_in,
+                  int *exact_connection_out,
+                  TrajectoryReedsShepp *trajectory_out,
+                  collision_checker_t *collision_checker_in = NULL);
+
+  /**
+   * \brief Computes the lengths of the shortest paths from a state to a
+   * batch of states.
+   *
+   * The batch is given as arrays of the positions and the headings of its
+   * states. The transformation to the frame of state_from_in is computed
+   * once. If lengths_max_in is not NULL, the families of paths that are not
+   * shorter than lengths_max_in are skipped, and the lengths of the paths
+   * that are not shorter are replaced by lengths_max_in.
+   *
+   * @param state_from_in The state that the paths start from.
+   * @param num_states The number of states in the batch.
+   * @param x_in, y_in, t_in The positions and headings of the states.
+   * @param lengths_max_in The lengths above which the paths need not be
+   *                       solved, or NULL.
+   * @param lengths_out The lengths of the paths, or lower bounds on the
+   *                    lengths that are not shorter than lengths_max_in.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int lengths_from(StateReedsShepp *state_from_in, int num_states,
+                   const double *x_in, const double *y_in, const double *t_in,
+                   const double *lengths_max_in, double *lengths_out);
+
+  int extend(StateReedsShepp *state_from_in,
+             StateReedsShepp *state_towards_in, int *exact_connection_out,
+             TrajectoryReedsShepp *trajectory_out,
+             std::list<StateReedsShepp *> *intermediate_vertices_out);
+
+  int extend_checked(StateReedsShepp *state_from_in,
+                     StateReedsShepp *state_towards_in,
+                     collision_checker_t &collision_checker,
+                     int *exact_connection_out,
+                     TrajectoryReedsShepp *trajectory_out,
+                     std::list<StateReedsShepp *> *intermediate_vertices_out);
+
+  /**
+   * \brief Returns the Euclidean distance between the positions of the
+   * states, which bounds the length of any path between them.
+   */
+  double cost_lower_bound(StateReedsShepp *state_from_in,
+                          StateReedsShepp *state_towards_in);
+
+  /**
+   * \brief Returns the length of the shortest path between the states,
+   * which is the cost of the trajectory generated by extend().
+   */
+  double cost_extend_lower_bound(StateReedsShepp *state_from_in,
+                                 StateReedsShepp *state_towards_in);
+
+  int cost_extend_lower_bounds_from(StateReedsShepp *state_from_in,
+                                    StateReedsShepp **states_towards_in,
+                                    int num_states, const double *costs_max_in,
+                                    double *bounds_out);
+
+  int cost_extend_lower_bounds_to(StateReedsShepp **states_from_in,
+                                  StateReedsShepp *state_towards_in,
+                                  int num_states, const double *costs_max_in,
+                                  double *bounds_out);
+};
+} // namespace extenders
+} // namespace smp
+
+#endif
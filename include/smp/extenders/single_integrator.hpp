@@ -0,0 +1,172 @@
+/*! \file components/extenders/single_integrator.h
+  \brief The single integrator system components. State, input, and extender
+  definitions.
+
+  This file implements the state, input, and extender classes for a
+  d-dimensional single integrator system, where d is a template parameter.
+
+  * Copyright (C) 2018 Sertac Karaman
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#ifndef _SMP_SYSTEM_SINGLE_INTEGRATOR_H_
+#define _SMP_SYSTEM_SINGLE_INTEGRATOR_H_
+
+#include <smp/extenders/base.hpp>
+#include <smp/input_array_double.hpp>
+#include <smp/state_array_double.hpp>
+
+#include <cmath>
+#include <list>
+
+namespace smp {
+
+//! State data structure for the single integrator dynamics
+/*!
+  This class implements the state data structure for the single integrator
+  dynamics. The number of state variables is the number of dimensions, and
+  the state variables are the positions along the axes, in their usual
+  order.
+
+  \ingroup states
+*/
+template <int NUM_DIMENSIONS>
+class StateSingleIntegrator : public StateArrayDouble<NUM_DIMENSIONS> {};
+
+//! Input data structure for the single integrator dynamics
+/*!
+  This class implements the input data structure for the single integrator
+  dynamics. The only input variable is the time it takes to execute the
+  trajectory segment at unit speed, i.e., its length.
+
+  \ingroup inputs
+*/
+class InputSingleIntegrator : public InputArrayDouble<1> {};
+
+namespace extenders {
+
+//! Extender function with single integrator dynamics.
+/*!
+  This class implements an extender with single integrator dynamics, which can
+  be used for planning in configuration spaces. The trajectory is the
+  straight line between the states, truncated to the length set with
+  set_max_length(), which is 1.0 by default. The trajectory holds only the
+  state at its end, and the collision checker is expected to check the
+  segment between the states, as collision_checkers::Standard does. The
+  number of dimensions of the state space is a template argument for the
+  class.
+
+  \ingroup extenders
+*/
+template <int NUM_DIMENSIONS>
+class SingleIntegrator : public Base<StateSingleIntegrator<NUM_DIMENSIONS>,
+                                     InputSingleIntegrator> {
+
+  using state_t = StateSingleIntegrator<NUM_DIMENSIONS>;
+  using input_t = InputSingleIntegrator;
+  using trajectory_t = Trajectory<state_t, input_t>;
+
+  double max_length{1.0};
+
+public:
+  SingleIntegrator() {}
+  ~SingleIntegrator() {}
+
+  /**
+   * \brief Sets the maximum length of the trajectory returned by the
+   * extender.
+   *
+   * If the trajectory connecting two given states is longer than the value
+   * specified by the argument of this function, then only the maximum-length
+   * prefix of this trajectory is returned, and the connection is not exact.
+   * By default, the max_length parameter is set to 1.0.
+   *
+   * @param max_length_in Maximum length of a trajectory.
+   *
+   * @returns Returns 1 for success, and a non-positive number to indicate
+   * error.
+   */
+  int set_max_length(double max_length_in) {
+
+    if (!(max_length_in > 0.0))
+      return 0;
+
+    max_length = max_length_in;
+
+    return 1;
+  }
+
+  int extend(state_t *state_from_in, state_t *state_towards_in,
+             int *exact_connection_out, trajectory_t *trajectory_out,
+             std::list<state_t *> *intermediate_vertices_out) {
+
+    trajectory_out->list_states.clear();
+    trajectory_out->list_inputs.clear();
+    if (intermediate_vertices_out)
+      intermediate_vertices_out->clear();
+
+    double dists[NUM_DIMENSIONS];
+    double dist = 0.0;
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      dists[i] = (*state_towards_in)[i] - (*state_from_in)[i];
+      dist += dists[i] * dists[i];
+    }
+    dist = sqrt(dist);
+
+    state_t *state_new;
+    input_t *input_new = new input_t;
+
+    if (dist <= max_length) {
+      state_new = new state_t(*state_towards_in);
+      (*input_new)[0] = dist;
+      if (exact_connection_out)
+        *exact_connection_out = 1;
+    } else {
+      state_new = new state_t;
+      double scale = max_length / dist;
+      for (int i = 0; i < NUM_DIMENSIONS; i++)
+        (*state_new)[i] = (*state_from_in)[i] + dists[i] * scale;
+      (*input_new)[0] = max_length;
+      if (exact_connection_out)
+        *exact_connection_out = 0;
+    }
+
+    trajectory_out->list_states.push_back(state_new);
+    trajectory_out->list_inputs.push_back(input_new);
+
+    return 1;
+  }
+
+  /**
+   * \brief Returns the Euclidean distance between the states, which is the
+   * length of the trajectory that connects them exactly.
+   */
+  double cost_lower_bound(state_t *state_from_in, state_t *state_towards_in) {
+
+    double dist = 0.0;
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      double d = (*state_towards_in)[i] - (*state_from_in)[i];
+      dist += d * d;
+    }
+
+    return sqrt(dist);
+  }
+};
+
+} // namespace extenders
+} // namespace smp
+
+#endif
@@ -34,6 +34,7 @@
 #include <smp/types.hpp>
 
 #include <array>
+#include <cmath>
 #include <functional>
 
 namespace smp {
@@ -80,8 +81,21 @@ class MinimumTimeReachability : public model_checkers::Base<State, Input>,
   std::list<update_func_t> list_update_functions;
 
   vertex_t *min_cost_vertex; // A pointer to the minimum cost vertex in the tree
+  double min_cost;           // The cost of min_cost_vertex when it was chosen
   trajectory_t min_cost_trajectory; // A copy of the mininum cost trajectory
 
+  // All the vertices in the tree that reach the goal region
+  std::list<vertex_t *> list_goal_vertices;
+
+  // Copies the trajectory that reaches min_cost_vertex into
+  // min_cost_trajectory and calls the update functions.
+  void update_min_cost_trajectory();
+
+  // Chooses the minimum cost vertex among all the vertices that reach the
+  // goal region, except the ones with an infinite cost. Used when the cost
+  // of the current one increases or when it is deleted.
+  void select_min_cost_vertex();
+
   region_t region_goal;
 
 public:
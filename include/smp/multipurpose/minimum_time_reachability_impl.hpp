@@ -36,6 +36,7 @@ smp::multipurpose::MinimumTimeReachability<
     State, Input, NUM_DIMENSIONS>::MinimumTimeReachability() {
 
   min_cost_vertex = NULL;
+  min_cost = 0.0;
 
   for (int i = 0; i < NUM_DIMENSIONS; i++) {
     region_goal.center[i] = 0.0;
@@ -51,6 +52,8 @@ template <class State, class Input, int NUM_DIMENSIONS>
 smp::multipurpose::MinimumTimeReachability<State, Input, NUM_DIMENSIONS>::
     MinimumTimeReachability(const region_t &region_in) {
 
+  min_cost_vertex = NULL;
+  min_cost = 0.0;
   region_goal = region_in;
 }
 
@@ -69,6 +72,17 @@ int smp::multipurpose::MinimumTimeReachability<
 
   if (vertex_in->data.reaches_goal == true) {
 
+    // If the cost of the minimum cost vertex went up, e.g., because its
+    // branch was repaired after a map change, another vertex may be better.
+    // The same holds if the minimum cost vertex was cut off from the root.
+    if (((vertex_in == min_cost_vertex) &&
+         (vertex_in->data.total_cost > min_cost)) ||
+        ((min_cost_vertex != NULL) &&
+         std::isinf(min_cost_vertex->data.total_cost))) {
+      select_min_cost_vertex();
+      return 1;
+    }
+
     bool update_trajectory = false;
 
     if (min_cost_vertex == NULL) {
@@ -87,48 +101,82 @@ int smp::multipurpose::MinimumTimeReachability<
                 << vertex_in->data.total_cost << std::endl;
       fflush(stdout);
 
-      min_cost_trajectory.clear_delete();
+      update_min_cost_trajectory();
+    }
+  }
 
-      vertex_t *vertex_ptr = min_cost_vertex;
-      while (1) {
+  return 1;
+}
 
-        if (vertex_ptr->incoming_edges.size() == 0)
-          break;
+template <class State, class Input, int NUM_DIMENSIONS>
+void smp::multipurpose::MinimumTimeReachability<
+    State, Input, NUM_DIMENSIONS>::update_min_cost_trajectory() {
+
+  min_cost_trajectory.clear_delete();
 
-        edge_t *edge_curr = vertex_ptr->incoming_edges.back();
+  // Without a minimum cost vertex, the update functions get the empty
+  // trajectory, so that they drop the previous one.
+  min_cost = 0.0;
+  vertex_t *vertex_ptr = min_cost_vertex;
+  if (min_cost_vertex != NULL)
+    min_cost = min_cost_vertex->data.total_cost;
 
-        trajectory_t *trajectory_curr = edge_curr->trajectory_edge;
-        min_cost_trajectory.list_states.push_front(
-            new State(*(vertex_ptr->state)));
+  while (vertex_ptr != NULL) {
 
-        for (typename std::list<State *>::reverse_iterator it_state =
-                 trajectory_curr->list_states.rbegin();
-             it_state != trajectory_curr->list_states.rend(); it_state++) {
-          min_cost_trajectory.list_states.push_front(new State(**it_state));
-        }
+    if (vertex_ptr->incoming_edges.size() == 0)
+      break;
 
-        for (typename std::list<Input *>::reverse_iterator it_input =
-                 trajectory_curr->list_inputs.rbegin();
-             it_input != trajectory_curr->list_inputs.rend(); it_input++) {
-          min_cost_trajectory.list_inputs.push_front(new Input(**it_input));
-        }
+    edge_t *edge_curr = vertex_ptr->incoming_edges.back();
 
-        vertex_ptr = edge_curr->vertex_src;
-      }
+    trajectory_t *trajectory_curr = edge_curr->trajectory_edge;
+    min_cost_trajectory.list_states.push_front(
+        new State(*(vertex_ptr->state)));
 
-      // std::cout << "Min Cost Traj contains: " <<
-      // min_cost_trajectory.list_states.size() << " states";
-      // Call all the update functions
-      for (typename std::list<update_func_t>::iterator it_func =
-               list_update_functions.begin();
-           it_func != list_update_functions.end(); it_func++) {
+    for (typename std::list<State *>::reverse_iterator it_state =
+             trajectory_curr->list_states.rbegin();
+         it_state != trajectory_curr->list_states.rend(); it_state++) {
+      min_cost_trajectory.list_states.push_front(new State(**it_state));
+    }
 
-        (*it_func)(&min_cost_trajectory);
-      }
+    for (typename std::list<Input *>::reverse_iterator it_input =
+             trajectory_curr->list_inputs.rbegin();
+         it_input != trajectory_curr->list_inputs.rend(); it_input++) {
+      min_cost_trajectory.list_inputs.push_front(new Input(**it_input));
     }
+
+    vertex_ptr = edge_curr->vertex_src;
   }
 
-  return 1;
+  // std::cout << "Min Cost Traj contains: " <<
+  // min_cost_trajectory.list_states.size() << " states";
+  // Call all the update functions
+  for (typename std::list<update_func_t>::iterator it_func =
+           list_update_functions.begin();
+       it_func != list_update_functions.end(); it_func++) {
+
+    (*it_func)(&min_cost_trajectory);
+  }
+}
+
+template <class State, class Input, int NUM_DIMENSIONS>
+void smp::multipurpose::MinimumTimeReachability<
+    State, Input, NUM_DIMENSIONS>::select_min_cost_vertex() {
+
+  min_cost_vertex = NULL;
+  for (typename std::list<vertex_t *>::iterator iter =
+           list_goal_vertices.begin();
+       iter != list_goal_vertices.end(); iter++) {
+    // Vertices with an infinite cost are not connected to the root, e.g.,
+    // the orphans of RRTStar::invalidate_edges().
+    if (std::isinf((*iter)->data.total_cost))
+      continue;
+
+    if ((min_cost_vertex == NULL) ||
+        ((*iter)->data.total_cost < min_cost_vertex->data.total_cost))
+      min_cost_vertex = *iter;
+  }
+
+  update_min_cost_trajectory();
 }
 
 template <class State, class Input, int NUM_DIMENSIONS>
@@ -144,6 +192,9 @@ int smp::multipurpose::MinimumTimeReachability<State, Input, NUM_DIMENSIONS>::
 
   vertex_in->data.reaches_goal = reaches_goal(vertex_in);
 
+  if (vertex_in->data.reaches_goal)
+    list_goal_vertices.push_back(vertex_in);
+
   return 1;
 }
 
@@ -194,6 +245,15 @@ template <class State, class Input, int NUM_DIMENSIONS>
 int smp::multipurpose::MinimumTimeReachability<State, Input, NUM_DIMENSIONS>::
     mc_update_delete_vertex(vertex_t *vertex_in) {
 
+  if (vertex_in->data.reaches_goal == false)
+    return 1;
+
+  list_goal_vertices.remove(vertex_in);
+
+  // Do not keep a dangling pointer to the deleted vertex.
+  if (vertex_in == min_cost_vertex)
+    select_min_cost_vertex();
+
   return 1;
 }
 
@@ -0,0 +1,259 @@
+/*! \file planners/edge_index.h
+  \brief A spatial index of the edges of the graph maintained by a planner
+
+  This file implements a grid of buckets that maps regions of the plane to the
+  edges of the graph whose trajectories pass through them. It is kept up to
+  date through the edge update functions of the planner, and is used to find
+  the edges that have to be checked again when part of the map changes.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <smp/vertex_edge.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace smp {
+namespace planners {
+
+//! Spatial index of the edges of a graph.
+/*!
+  The plane is divided into square buckets. Every edge is stored in all the
+  buckets that the bounding boxes of its consecutive state pairs (from the
+  source vertex, through the states of its trajectory, to the destination
+  vertex) intersect, after growing them by the reach of the collision checker.
+  The positions are the first two state variables. States outside the grid are
+  clamped to its border buckets.
+
+  Register update_insert_edge() and update_delete_edge() with the planner,
+  e.g.,
+  \code
+  planner.register_new_update_function_edge_insert(
+      std::bind(&EdgeIndex<State, Input>::update_insert_edge, &index,
+                std::placeholders::_1));
+  \endcode
+  and similarly for edge deletion.
+
+  \ingroup planners
+*/
+template <class State, class Input> class EdgeIndex {
+
+  using vertex_t = Vertex<State, Input>;
+  using edge_t = Edge<State, Input>;
+
+  double origin_x;
+  double origin_y;
+  double bucket_size;
+  int size_x;
+  int size_y;
+  double reach;
+
+  std::vector<std::vector<edge_t *>> buckets;
+
+  // The buckets each edge is stored in.
+  std::unordered_map<edge_t *, std::vector<int>> edge_buckets;
+
+  inline int bucket_x(double x) const {
+    int index = (int)floor((x - origin_x) / bucket_size);
+    return std::min(std::max(index, 0), size_x - 1);
+  }
+
+  inline int bucket_y(double y) const {
+    int index = (int)floor((y - origin_y) / bucket_size);
+    return std::min(std::max(index, 0), size_y - 1);
+  }
+
+  // Appends the buckets that intersect the rectangle and are not in the list
+  // yet.
+  void add_buckets(double x_min, double y_min, double x_max, double y_max,
+                   std::vector<int> &list_buckets) const {
+
+    for (int y = bucket_y(y_min); y <= bucket_y(y_max); y++) {
+      for (int x = bucket_x(x_min); x <= bucket_x(x_max); x++) {
+        int bucket = y * size_x + x;
+        if (std::find(list_buckets.begin(), list_buckets.end(), bucket) ==
+            list_buckets.end())
+          list_buckets.push_back(bucket);
+      }
+    }
+  }
+
+public:
+  EdgeIndex()
+      : origin_x(0.0), origin_y(0.0), bucket_size(1.0), size_x(1), size_y(1),
+        reach(0.0), buckets(1) {}
+
+  ~EdgeIndex() {}
+
+  /**
+   * \brief Sets the area covered by the grid of buckets.
+   *
+   * Removes all edges from the index.
+   *
+   * @param origin_x_in World x coordinate of the lower-left corner.
+   * @param origin_y_in World y coordinate of the lower-left corner.
+   * @param width Width of the area in meters.
+   * @param height Height of the area in meters.
+   * @param bucket_size_in Side of a bucket in meters.
+   *
+   * @returns Returns 1 for success, a non-positive value to indicate error.
+   */
+  int set_grid(double origin_x_in, double origin_y_in, double width,
+               double height, double bucket_size_in) {
+
+    if ((bucket_size_in <= 0.0) || (width <= 0.0) || (height <= 0.0)) {
+      std::cerr << "[set_grid]: INVALID GRID!\n";
+      return 0;
+    }
+
+    origin_x = origin_x_in;
+    origin_y = origin_y_in;
+    bucket_size = bucket_size_in;
+    size_x = (int)ceil(width / bucket_size);
+    size_y = (int)ceil(height / bucket_size);
+
+    clear();
+
+    return 1;
+  }
+
+  /**
+   * \brief Sets how far from a state the collision checker looks at the map.
+   *
+   * Only applies to the edges inserted after this call.
+   */
+  inline void set_reach(double reach_in) { reach = reach_in; }
+
+  /**
+   * \brief Removes all edges from the index.
+   */
+  void clear() {
+    buckets.assign(size_x * size_y, std::vector<edge_t *>());
+    edge_buckets.clear();
+  }
+
+  /**
+   * \brief Adds an edge to the index.
+   *
+   * Meant to be registered as an edge insertion update function.
+   *
+   * @returns Returns 1 for success, a non-positive value to indicate error.
+   */
+  int update_insert_edge(edge_t *edge_in) {
+
+    std::vector<int> &list_buckets = edge_buckets[edge_in];
+    list_buckets.clear();
+
+    State *state_prev = edge_in->vertex_src->state;
+    std::list<State *> &list_states = edge_in->trajectory_edge->list_states;
+    typename std::list<State *>::iterator iter = list_states.begin();
+
+    while (true) {
+      State *state_curr;
+      if (iter != list_states.end())
+        state_curr = *(iter++);
+      else
+        state_curr = edge_in->vertex_dst->state;
+
+      add_buckets(
+          std::min(state_prev->state_vars[0], state_curr->state_vars[0]) -
+              reach,
+          std::min(state_prev->state_vars[1], state_curr->state_vars[1]) -
+              reach,
+          std::max(state_prev->state_vars[0], state_curr->state_vars[0]) +
+              reach,
+          std::max(state_prev->state_vars[1], state_curr->state_vars[1]) +
+              reach,
+          list_buckets);
+
+      if (state_curr == edge_in->vertex_dst->state)
+        break;
+      state_prev = state_curr;
+    }
+
+    for (int bucket : list_buckets)
+      buckets[bucket].push_back(edge_in);
+
+    return 1;
+  }
+
+  /**
+   * \brief Removes an edge from the index.
+   *
+   * Meant to be registered as an edge deletion update function.
+   *
+   * @returns Returns 1 for success, a non-positive value to indicate error.
+   */
+  int update_delete_edge(edge_t *edge_in) {
+
+    typename std::unordered_map<edge_t *, std::vector<int>>::iterator
+        it_edge = edge_buckets.find(edge_in);
+    if (it_edge == edge_buckets.end())
+      return 1;
+
+    for (int bucket : it_edge->second) {
+      std::vector<edge_t *> &list_edges = buckets[bucket];
+      typename std::vector<edge_t *>::iterator iter =
+          std::find(list_edges.begin(), list_edges.end(), edge_in);
+      if (iter != list_edges.end()) {
+        *iter = list_edges.back();
+        list_edges.pop_back();
+      }
+    }
+    edge_buckets.erase(it_edge);
+
+    return 1;
+  }
+
+  /**
+   * \brief Finds the edges that pass near a rectangle.
+   *
+   * Appends to the list every edge stored in a bucket that intersects the
+   * rectangle [x_min, x_max] x [y_min, y_max]. Every edge whose trajectory
+   * passes within the reach of the rectangle is found, possibly along with
+   * some that do not.
+   *
+   * @returns Returns the number of edges found.
+   */
+  int find_edges(double x_min, double y_min, double x_max, double y_max,
+                 std::list<edge_t *> *list_edges_out) const {
+
+    std::unordered_set<edge_t *> found;
+    for (int y = bucket_y(y_min); y <= bucket_y(y_max); y++) {
+      for (int x = bucket_x(x_min); x <= bucket_x(x_max); x++) {
+        for (edge_t *edge : buckets[y * size_x + x]) {
+          if (found.insert(edge).second)
+            list_edges_out->push_back(edge);
+        }
+      }
+    }
+
+    return (int)found.size();
+  }
+
+  inline int get_num_edges() const { return (int)edge_buckets.size(); }
+};
+} // namespace planners
+} // namespace smp
@@ -27,7 +27,13 @@
 #include <smp/planners/base_incremental.hpp>
 #include <smp/planners/parameters.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <unordered_set>
+#include <vector>
 
 namespace smp {
 
@@ -54,19 +60,66 @@ class RRTStar : public BaseIncremental<State, Input> {
   using cost_evaluator_t = cost_evaluators::Base<State, Input>;
 
 private:
-  // This function adds the given state to the beginning of the tracjetory and
-  // calls the collision checker.
-  int check_extended_trajectory_for_collision(State *state,
-                                              trajectory_t *trajectory) {
+  // This function checks the trajectory of an edge, from its source state to
+  // its destination state, for collision.
+  int check_edge_for_collision(edge_t *edge) {
 
-    trajectory->list_states.push_front(state);
-    int collision_check =
-        this->collision_checker.check_collision(trajectory->list_states);
-    trajectory->list_states.pop_front();
+    std::list<State *> &list_states = edge->trajectory_edge->list_states;
+    list_states.push_front(edge->vertex_src->state);
+    list_states.push_back(edge->vertex_dst->state);
+    int collision_check = this->collision_checker.check_collision(list_states);
+    list_states.pop_front();
+    list_states.pop_back();
 
     return collision_check;
   }
 
+  // Adds the vertex and all its descendants to the given set.
+  void mark_subtree(vertex_t *vertex_in,
+                    std::unordered_set<vertex_t *> &set_vertices) {
+
+    std::vector<vertex_t *> stack(1, vertex_in);
+    while (!stack.empty()) {
+      vertex_t *vertex_curr = stack.back();
+      stack.pop_back();
+      if (!set_vertices.insert(vertex_curr).second)
+        continue;
+      for (edge_t *edge_curr : vertex_curr->outgoing_edges)
+        stack.push_back(edge_curr->vertex_dst);
+    }
+  }
+
+  // The vertices in the ball, their states, the costs above which the
+  // bounds of their extensions need not be exact, the bounds, and the order
+  // in which they are tried.
+  std::vector<vertex_t *> near_vertices;
+  std::vector<State *> near_states;
+  std::vector<double> near_costs_max;
+  std::vector<double> near_bounds;
+  std::vector<int> near_order;
+
+  // Fills the buffers of the vertices in the ball, except vertex_skip.
+  void gather_near_vertices(const std::list<void *> &list_vertices_in,
+                            vertex_t *vertex_skip) {
+
+    near_vertices.clear();
+    near_states.clear();
+    for (void *vertex_ptr : list_vertices_in) {
+      vertex_t *vertex_curr = (vertex_t *)vertex_ptr;
+      if (vertex_curr == vertex_skip)
+        continue;
+      near_vertices.push_back(vertex_curr);
+      near_states.push_back(vertex_curr->state);
+    }
+
+    near_costs_max.resize(near_vertices.size());
+    near_bounds.resize(near_vertices.size());
+    near_order.resize(near_vertices.size());
+  }
+
+  // Computes the radius of the ball that the connections are sought within.
+  double compute_radius();
+
   // The radius that was used in the previous iteration
   double radius_last;
 
@@ -192,6 +245,28 @@ planner is
    */
   double get_ball_radius_last() { return radius_last; }
 
+  /**
+   * \brief Removes the parts of the tree that a map change invalidated.
+   *
+   * Checks the given edges for collision again, e.g., the edges that an
+   * EdgeIndex finds around the cells that changed, and deletes the ones
+   * that now collide. The subtrees below the deleted edges are orphaned. If
+   * repair is enabled, the planner tries to reconnect the root of every
+   * orphaned subtree to the vertex within the connection radius that gives
+   * it the lowest cost, among the vertices still connected to the root of
+   * the tree. The orphaned subtrees that cannot be reconnected are deleted.
+   * Until then, the orphaned vertices have an infinite cost, which the cost
+   * evaluator must not choose as the best one.
+   *
+   * @param list_edges_in The edges to check. Every edge must be in the tree.
+   * @param repair Whether to try to reconnect the orphaned subtrees.
+   *
+   * @returns Returns the number of deleted vertices, or a negative number to
+   *          indicate failure.
+   */
+  int invalidate_edges(const std::list<edge_t *> &list_edges_in,
+                       bool repair = true);
+
   /**
    * \brief Initiate one iteration of the RRT* algorithm.
    *
@@ -89,6 +89,150 @@ float smp::planners::RRTStar<State, Input>::get_planning_time() {
   return planning_time;
 }
 
+template <class State, class Input>
+double smp::planners::RRTStar<State, Input>::compute_radius() {
+
+  double radius;
+  if (parameters.get_fixed_radius() < 0.0) {
+    double num_vertices = (double)(this->get_num_vertices());
+    radius = parameters.get_gamma() *
+             pow(log(num_vertices) / num_vertices,
+                 1.0 / ((double)(parameters.get_dimension())));
+
+    // if (this->get_num_vertices()%1000 == 0)
+    //   std::cout << "radius " << radius << std::endl;
+
+    if (radius > parameters.get_max_radius())
+      radius = parameters.get_max_radius();
+  } else
+    radius = parameters.get_fixed_radius();
+
+  return radius;
+}
+
+template <class State, class Input>
+int smp::planners::RRTStar<State, Input>::invalidate_edges(
+    const std::list<edge_t *> &list_edges_in, bool repair) {
+
+  if (this->root_vertex == NULL)
+    return -1;
+
+  // 1. Check the edges again, and delete the ones that collide. Their
+  // destination vertices become the roots of orphaned subtrees.
+  std::vector<edge_t *> list_edges_colliding;
+  for (edge_t *edge_curr : list_edges_in) {
+    if (check_edge_for_collision(edge_curr) == 0)
+      list_edges_colliding.push_back(edge_curr);
+  }
+
+  if (list_edges_colliding.empty())
+    return 0;
+
+  std::vector<vertex_t *> list_orphans;
+  for (edge_t *edge_curr : list_edges_colliding) {
+    list_orphans.push_back(edge_curr->vertex_dst);
+    this->delete_edge(edge_curr);
+  }
+
+  // 2. Find the vertices that are still connected to the root.
+  std::unordered_set<vertex_t *> set_connected;
+  mark_subtree(this->root_vertex, set_connected);
+
+  // The orphaned vertices keep the cost they had through the deleted edges
+  // until they are reconnected or deleted. Make them infinitely expensive,
+  // so that the cost evaluator never chooses one of them as the best vertex
+  // in the meantime.
+  for (vertex_t *vertex_curr : this->list_vertices) {
+    if (set_connected.find(vertex_curr) == set_connected.end())
+      vertex_curr->data.total_cost = std::numeric_limits<double>::infinity();
+  }
+
+  // 3. Try to reconnect every orphaned subtree to the connected vertices.
+  if (repair) {
+    double radius = compute_radius();
+
+    for (vertex_t *vertex_orphan : list_orphans) {
+
+      std::list<void *> list_vertices_in_ball;
+      this->distance_evaluator.find_near_vertices_r(
+          vertex_orphan->state, radius, &list_vertices_in_ball);
+
+      vertex_t *vertex_parent = NULL;
+      trajectory_t *trajectory_parent = NULL;
+      std::list<State *> *intermediate_vertices_parent = NULL;
+      double cost_trajectory_from_parent = 0.0;
+
+      for (std::list<void *>::iterator iter = list_vertices_in_ball.begin();
+           iter != list_vertices_in_ball.end(); iter++) {
+        vertex_t *vertex_curr = (vertex_t *)(*iter);
+
+        if (set_connected.find(vertex_curr) == set_connected.end())
+          continue;
+
+        if ((vertex_parent != NULL) &&
+            (vertex_curr->data.total_cost +
+                 this->extender.cost_extend_lower_bound(
+                     vertex_curr->state, vertex_orphan->state) >=
+             vertex_parent->data.total_cost + cost_trajectory_from_parent))
+          continue;
+
+        trajectory_t *trajectory_curr = new trajectory_t;
+        std::list<State *> *intermediate_vertices_curr =
+            new std::list<State *>;
+        int exact_connection = -1;
+        if ((this->extender.extend_checked(
+                 vertex_curr->state, vertex_orphan->state,
+                 this->collision_checker, &exact_connection, trajectory_curr,
+                 intermediate_vertices_curr) == 1) &&
+            (exact_connection == 1)) {
+
+          double cost_trajectory_from_curr =
+              this->cost_evaluator.evaluate_cost_trajectory(
+                  vertex_curr->state, trajectory_curr);
+
+          if ((vertex_parent == NULL) ||
+              (vertex_curr->data.total_cost + cost_trajectory_from_curr <
+               vertex_parent->data.total_cost + cost_trajectory_from_parent)) {
+            std::swap(trajectory_curr, trajectory_parent);
+            std::swap(intermediate_vertices_curr,
+                      intermediate_vertices_parent);
+            vertex_parent = vertex_curr;
+            cost_trajectory_from_parent = cost_trajectory_from_curr;
+          }
+        }
+
+        delete trajectory_curr;
+        delete intermediate_vertices_curr;
+      }
+
+      if (vertex_parent == NULL)
+        continue;
+
+      this->insert_trajectory(vertex_parent, trajectory_parent,
+                              intermediate_vertices_parent, vertex_orphan);
+      edge_t *edge_parent = vertex_orphan->incoming_edges.back();
+      edge_parent->data.edge_cost = cost_trajectory_from_parent;
+
+      this->propagate_cost(vertex_orphan, vertex_parent->data.total_cost +
+                                              cost_trajectory_from_parent);
+
+      mark_subtree(vertex_orphan, set_connected);
+    }
+  }
+
+  // 4. Delete the vertices that are not connected to the root.
+  std::vector<vertex_t *> list_vertices_deleted;
+  for (vertex_t *vertex_curr : this->list_vertices) {
+    if (set_connected.find(vertex_curr) == set_connected.end())
+      list_vertices_deleted.push_back(vertex_curr);
+  }
+
+  for (vertex_t *vertex_curr : list_vertices_deleted)
+    this->delete_vertex(vertex_curr);
+
+  return (int)list_vertices_deleted.size();
+}
+
 template <class State, class Input>
 int smp::planners::RRTStar<State, Input>::iteration() {
 
@@ -97,10 +241,12 @@ int smp::planners::RRTStar<State, Input>::iteration() {
   // classes)
 
   // 1. Sample a new state from the obstacle-free space
-  State *state_sample;
-  this->sampler.sample(&state_sample);
+  State state_sample_storage;
+  State *state_sample = &state_sample_storage;
+  this->sampler.sample_into(state_sample);
   if (this->collision_checker.check_collision(state_sample) == 0) {
-    delete state_sample;
+
+    this->sampler.update(state_sample, 0.0);
 
     auto end_time = clock.now();
     planning_time += ((end_time - start_time).count() / 1e9);
@@ -115,221 +261,237 @@ int smp::planners::RRTStar<State, Input>::iteration() {
 
   // 3. Extend the nearest vertex towards the sample
 
-  double radius;
-  if (parameters.get_fixed_radius() < 0.0) {
-    double num_vertices = (double)(this->get_num_vertices());
-    radius = parameters.get_gamma() *
-             pow(log(num_vertices) / num_vertices,
-                 1.0 / ((double)(parameters.get_dimension())));
-
-    // if (this->get_num_vertices()%1000 == 0)
-    //   std::cout << "radius " << radius << std::endl;
-
-    if (radius > parameters.get_max_radius())
-      radius = parameters.get_max_radius();
-  } else
-    radius = parameters.get_fixed_radius();
+  double radius = compute_radius();
 
   radius_last = radius;
 
+  // 4. Check the new trajectory for collision as it is generated
   int exact_connection = -1;
   trajectory_t *trajectory = new trajectory_t;
   std::list<State *> *intermediate_vertices = new std::list<State *>;
-  if (this->extender.extend(vertex_nearest->state, state_sample,
-                            &exact_connection, trajectory,
-                            intermediate_vertices) == 1) {
-    // If the extension is successful
-
-    // 4. Check the new trajectory for collision
-    if (check_extended_trajectory_for_collision(vertex_nearest->state,
-                                                trajectory) == 1) {
-      // If the trajectory is collision free
-
-      // 5. Find the parent state
-      vertex_t *vertex_parent = vertex_nearest;
-      trajectory_t *trajectory_parent = trajectory;
-      std::list<State *> *intermediate_vertices_parent = intermediate_vertices;
-
-      double cost_trajectory_from_parent =
-          this->cost_evaluator.evaluate_cost_trajectory(vertex_parent->state,
-                                                        trajectory_parent);
-      double cost_parent =
-          vertex_parent->data.total_cost + cost_trajectory_from_parent;
-
-      // Define the new variables that are used in both phase 1 and 2.
-      std::list<void *> list_vertices_in_ball;
-      State *state_extended = NULL;
-
-      if (parameters.get_phase() >= 1) { // Check whether phase 1 should occur.
-
-        state_extended =
-            new State(*(trajectory_parent->list_states
-                            .back())); // Create a copy of the final state
-
-        // Compute the set of all nodes that reside in a ball of a certain
-        // radius centered at the extended state
-        this->distance_evaluator.find_near_vertices_r(state_extended, radius,
-                                                      &list_vertices_in_ball);
-
-        for (typename std::list<void *>::iterator iter =
-                 list_vertices_in_ball.begin();
-             iter != list_vertices_in_ball.end(); iter++) {
-          vertex_t *vertex_curr = (vertex_t *)(*iter);
-
-          // Skip if current vertex is the same as the nearest vertex
-          if (vertex_curr == vertex_nearest)
-            continue;
-
-          // Attempt an extension from vertex_curr to the extended state
-          trajectory_t *trajectory_curr = new trajectory_t;
-          std::list<State *> *intermediate_vertices_curr =
-              new std::list<State *>;
-          exact_connection = -1;
-          if (this->extender.extend(vertex_curr->state, state_extended,
-                                    &exact_connection, trajectory_curr,
-                                    intermediate_vertices_curr) == 1) {
-
-            if ((exact_connection == 1) &&
-                (check_extended_trajectory_for_collision(
-                     vertex_curr->state, trajectory_curr) == 1)) {
-              // Calculate the cost to get to the extended state with the new
-              // trajectory
-              double cost_trajectory_from_curr =
-                  this->cost_evaluator.evaluate_cost_trajectory(
-                      vertex_curr->state, trajectory_curr);
-              double cost_curr =
-                  vertex_curr->data.total_cost + cost_trajectory_from_curr;
-
-              // Check whether the total cost through the new vertex is less
-              // than the parent
-              if (cost_curr < cost_parent) {
-
-                // Make new vertex the parent vertex
-                vertex_parent = vertex_curr;
-
-                trajectory_t *trajectory_tmp =
-                    trajectory_parent; // Swap trajectory_parent and
-                                       // trajectory_curr
-                trajectory_parent =
-                    trajectory_curr; //   to properly free the memory later
-                trajectory_curr = trajectory_tmp;
-
-                std::list<State *> *intermediate_vertices_tmp =
-                    intermediate_vertices_parent; // Swap the intermediate
-                                                  // vertices
-                intermediate_vertices_parent =
-                    intermediate_vertices_curr; //   to properly free the memory
-                                                //   later
-                intermediate_vertices_curr = intermediate_vertices_tmp;
-
-                cost_trajectory_from_parent = cost_trajectory_from_curr;
-                cost_parent = cost_curr;
-              }
-            }
+  if (this->extender.extend_checked(vertex_nearest->state, state_sample,
+                                    this->collision_checker, &exact_connection,
+                                    trajectory, intermediate_vertices) == 1) {
+    // If the extension is successful and collision free
+
+    // 5. Find the parent state
+    vertex_t *vertex_parent = vertex_nearest;
+    trajectory_t *trajectory_parent = trajectory;
+    std::list<State *> *intermediate_vertices_parent = intermediate_vertices;
+
+    double cost_trajectory_from_parent =
+        this->cost_evaluator.evaluate_cost_trajectory(vertex_parent->state,
+                                                      trajectory_parent);
+    double cost_parent =
+        vertex_parent->data.total_cost + cost_trajectory_from_parent;
+
+    // Define the new variables that are used in both phase 1 and 2.
+    std::list<void *> list_vertices_in_ball;
+    State *state_extended = NULL;
+
+    if (parameters.get_phase() >= 1) { // Check whether phase 1 should occur.
+
+      state_extended =
+          new State(*(trajectory_parent->list_states
+                          .back())); // Create a copy of the final state
+
+      // Compute the set of all nodes that reside in a ball of a certain
+      // radius centered at the extended state
+      this->distance_evaluator.find_near_vertices_r(state_extended, radius,
+                                                    &list_vertices_in_ball);
+
+      // Bound the costs through all vertices in the ball at once, except
+      // the nearest vertex, and try them in the order of their bounds
+      gather_near_vertices(list_vertices_in_ball, vertex_nearest);
+      int num_near = (int)near_vertices.size();
+      for (int i = 0; i < num_near; i++)
+        near_costs_max[i] = cost_parent - near_vertices[i]->data.total_cost;
+      this->extender.cost_extend_lower_bounds_to(
+          near_states.data(), state_extended, num_near,
+          near_costs_max.data(), near_bounds.data());
+
+      for (int i = 0; i < num_near; i++) {
+        near_bounds[i] += near_vertices[i]->data.total_cost;
+        near_order[i] = i;
+      }
+      std::sort(near_order.begin(), near_order.end(),
+                [this](int first, int second) {
+                  return near_bounds[first] < near_bounds[second];
+                });
+
+      for (int k = 0; k < num_near; k++) {
+        vertex_t *vertex_curr = near_vertices[near_order[k]];
+
+        // Stop if the trajectories from the remaining vertices cannot be
+        // cheaper than the one from the parent
+        if (near_bounds[near_order[k]] >= cost_parent)
+          break;
+
+        // Attempt an extension from vertex_curr to the extended state
+        trajectory_t *trajectory_curr = new trajectory_t;
+        std::list<State *> *intermediate_vertices_curr =
+            new std::list<State *>;
+        exact_connection = -1;
+        // The trajectory is checked for collision as it is generated, so
+        // that a blocked extension stops at the obstacle
+        if ((this->extender.extend_checked(
+                 vertex_curr->state, state_extended, this->collision_checker,
+                 &exact_connection, trajectory_curr,
+                 intermediate_vertices_curr) == 1) &&
+            (exact_connection == 1)) {
+
+          // Calculate the cost to get to the extended state with the new
+          // trajectory
+          double cost_trajectory_from_curr =
+              this->cost_evaluator.evaluate_cost_trajectory(
+                  vertex_curr->state, trajectory_curr);
+          double cost_curr =
+              vertex_curr->data.total_cost + cost_trajectory_from_curr;
+
+          // Check whether the total cost through the new vertex is less
+          // than the parent
+          if (cost_curr < cost_parent) {
+
+            // Make new vertex the parent vertex
+            vertex_parent = vertex_curr;
+
+            trajectory_t *trajectory_tmp =
+                trajectory_parent; // Swap trajectory_parent and
+                                   // trajectory_curr
+            trajectory_parent =
+                trajectory_curr; //   to properly free the memory later
+            trajectory_curr = trajectory_tmp;
+
+            std::list<State *> *intermediate_vertices_tmp =
+                intermediate_vertices_parent; // Swap the intermediate
+                                              // vertices
+            intermediate_vertices_parent =
+                intermediate_vertices_curr; //   to properly free the memory
+                                            //   later
+            intermediate_vertices_curr = intermediate_vertices_tmp;
+
+            cost_trajectory_from_parent = cost_trajectory_from_curr;
+            cost_parent = cost_curr;
           }
-
-          delete trajectory_curr;
-          delete intermediate_vertices_curr;
         }
+
+        delete trajectory_curr;
+        delete intermediate_vertices_curr;
       }
+    }
 
-      // Create a new vertex
-      this->insert_trajectory(vertex_parent, trajectory_parent,
-                              intermediate_vertices_parent);
-
-      // Update the cost of the edge and the vertex
-      vertex_t *vertex_last = this->list_vertices.back();
-      vertex_last->data.total_cost = cost_parent;
-      cost_evaluator.ce_update_vertex_cost(vertex_last);
-
-      edge_t *edge_last = vertex_parent->outgoing_edges.back();
-      edge_last->data.edge_cost = cost_trajectory_from_parent;
-
-      if (parameters.get_phase() >= 2) { // Check whether phase 2 should occur
-
-        // 6. Extend from the new vertex to the existing vertices in the ball to
-        // rewire the tree
-        for (std::list<void *>::iterator iter = list_vertices_in_ball.begin();
-             iter != list_vertices_in_ball.end(); iter++) {
-
-          vertex_t *vertex_curr = (vertex_t *)(*iter);
-
-          if (vertex_curr == vertex_last)
-            continue;
-
-          // Attempt an extension from the extended vertex to the current vertex
-          trajectory_t *trajectory_curr = new trajectory_t;
-          std::list<State *> *intermediate_vertices_curr =
-              new std::list<State *>;
-          bool free_tmp_memory = true;
-          exact_connection = -1;
-          if (this->extender.extend(vertex_last->state, vertex_curr->state,
-                                    &exact_connection, trajectory_curr,
-                                    intermediate_vertices_curr) == 1) {
-
-            if ((exact_connection == 1) &&
-                (check_extended_trajectory_for_collision(
-                     vertex_last->state, trajectory_curr) == 1)) {
-
-              // Calculate the cost to get to the extended state with the new
-              // trajectory
-              double cost_trajectory_to_curr =
-                  this->cost_evaluator.evaluate_cost_trajectory(
-                      vertex_last->state, trajectory_curr);
-              double cost_curr =
-                  vertex_last->data.total_cost + cost_trajectory_to_curr;
-
-              // Check whether cost of the trajectory through vertex_last is
-              // less than the current trajectory
-              if (cost_curr < vertex_curr->data.total_cost) {
-
-                // Delete the old parent of vertex_curr
-                edge_t *edge_parent_curr = vertex_curr->incoming_edges.back();
-                this->delete_edge(edge_parent_curr);
-
-                // Add vertex_curr's new parent
-                this->insert_trajectory(vertex_last, trajectory_curr,
-                                        intermediate_vertices_curr,
-                                        vertex_curr);
-                edge_t *edge_curr = vertex_curr->incoming_edges.back();
-                edge_curr->data.edge_cost = cost_trajectory_to_curr;
-
-                free_tmp_memory = false;
-
-                // Propagate the cost
-                this->propagate_cost(vertex_curr,
-                                     vertex_last->data.total_cost +
-                                         edge_curr->data.edge_cost);
-              }
-            }
+    // Create a new vertex
+    this->insert_trajectory(vertex_parent, trajectory_parent,
+                            intermediate_vertices_parent);
+
+    // Update the cost of the edge and the vertex
+    vertex_t *vertex_last = this->list_vertices.back();
+    vertex_last->data.total_cost = cost_parent;
+    cost_evaluator.ce_update_vertex_cost(vertex_last);
+
+    edge_t *edge_last = vertex_parent->outgoing_edges.back();
+    edge_last->data.edge_cost = cost_trajectory_from_parent;
+
+    // Whether the new vertex lowered the cost of existing vertices
+    bool rewired = false;
+
+    if (parameters.get_phase() >= 2) { // Check whether phase 2 should occur
+
+      // 6. Extend from the new vertex to the existing vertices in the ball to
+      // rewire the tree
+      // Bound the costs of the extensions to all vertices in the ball at
+      // once, except the new vertex
+      gather_near_vertices(list_vertices_in_ball, vertex_last);
+      int num_near = (int)near_vertices.size();
+      for (int i = 0; i < num_near; i++)
+        near_costs_max[i] = near_vertices[i]->data.total_cost -
+                            vertex_last->data.total_cost;
+      this->extender.cost_extend_lower_bounds_from(
+          vertex_last->state, near_states.data(), num_near,
+          near_costs_max.data(), near_bounds.data());
+
+      for (int i = 0; i < num_near; i++) {
+
+        vertex_t *vertex_curr = near_vertices[i];
+
+        // Skip if the trajectory through the new vertex cannot be cheaper
+        // than the current one
+        if (vertex_last->data.total_cost + near_bounds[i] >=
+            vertex_curr->data.total_cost)
+          continue;
+
+        // Attempt an extension from the extended vertex to the current vertex
+        trajectory_t *trajectory_curr = new trajectory_t;
+        std::list<State *> *intermediate_vertices_curr =
+            new std::list<State *>;
+        bool free_tmp_memory = true;
+        exact_connection = -1;
+        if ((this->extender.extend_checked(
+                 vertex_last->state, vertex_curr->state,
+                 this->collision_checker, &exact_connection, trajectory_curr,
+                 intermediate_vertices_curr) == 1) &&
+            (exact_connection == 1)) {
+
+          // Calculate the cost to get to the extended state with the new
+          // trajectory
+          double cost_trajectory_to_curr =
+              this->cost_evaluator.evaluate_cost_trajectory(
+                  vertex_last->state, trajectory_curr);
+          double cost_curr =
+              vertex_last->data.total_cost + cost_trajectory_to_curr;
+
+          // Check whether cost of the trajectory through vertex_last is
+          // less than the current trajectory
+          if (cost_curr < vertex_curr->data.total_cost) {
+
+            // Delete the old parent of vertex_curr
+            edge_t *edge_parent_curr = vertex_curr->incoming_edges.back();
+            this->delete_edge(edge_parent_curr);
+
+            // Add vertex_curr's new parent
+            this->insert_trajectory(vertex_last, trajectory_curr,
+                                    intermediate_vertices_curr,
+                                    vertex_curr);
+            edge_t *edge_curr = vertex_curr->incoming_edges.back();
+            edge_curr->data.edge_cost = cost_trajectory_to_curr;
+
+            free_tmp_memory = false;
+            rewired = true;
+
+            // Propagate the cost
+            this->propagate_cost(vertex_curr,
+                                 vertex_last->data.total_cost +
+                                     edge_curr->data.edge_cost);
           }
+        }
 
-          if (free_tmp_memory == true) {
-            delete trajectory_curr;
-            delete intermediate_vertices_curr;
-          }
+        if (free_tmp_memory == true) {
+          delete trajectory_curr;
+          delete intermediate_vertices_curr;
         }
       }
+    }
 
-      // Completed all phases, return with success
-      delete state_sample;
-      if (state_extended)
-        delete state_extended;
+    // Completed all phases, return with success
+    if (state_extended)
+      delete state_extended;
 
-      auto end_time = clock.now();
-      planning_time += ((end_time - start_time).count() / 1e9);
-      return 1;
-    }
+    this->sampler.update(state_sample, rewired ? 1.0 : 0.5);
+
+    auto end_time = clock.now();
+    planning_time += ((end_time - start_time).count() / 1e9);
+    return 1;
   }
 
   // 7. Handle the error case
   // If the first extension was not successful, or the trajectory was not
   // collision free,
   //     then free the memory and return failure
-  delete state_sample;
   delete trajectory;
   delete intermediate_vertices;
 
+  this->sampler.update(state_sample, 0.0);
+
   return 0;
 }
 
@@ -0,0 +1,292 @@
+/*! \file components/samplers/adaptive.h
+  \brief A sampler that learns which regions of the space are worth sampling
+
+  The sampler draws states from another sampler, and rejects part of the
+  states in the regions where the samples rarely extend the tree.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <smp/region.hpp>
+#include <smp/samplers/base.hpp>
+#include <smp/samplers/random.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Largest number of bins of the histogram.
+#define ADAPTIVE_MAX_BINS 65536
+
+namespace smp {
+namespace samplers {
+
+//! Implements a sampler that adapts its density to the outcome of samples.
+/*!
+  The support of the first two state variables, usually the position, is
+  divided into square bins. Every bin keeps an average of the rewards that
+  the planner reported for the samples in it, see Base::update(), together
+  with a prior of one sample with the largest reward. Bins that have not
+  been tried yet are thus favored, as in optimistic bandit policies.
+
+  The weight of a bin is floor + (1 - floor) * average, and a state drawn
+  from the other sampler is accepted with the weight of its bin. Regions
+  where samples keep failing, e.g., the interior of obstacles or rooms that
+  the tree cannot enter, fall to the floor. The floor bounds the expected
+  number of draws per sample by 1 / floor and keeps the planner
+  probabilistically complete.
+
+  Samples also fail in the regions that the tree has not reached yet, which
+  become useful later. The rewards are therefore discounted with the number
+  of updates since they were reported, over all bins, so that the average
+  of a bin that is not sampled returns to the prior.
+
+  Only the samples that this sampler produced are credited. A sampler that
+  draws some of its states from this one, such as TrajectoryBias or Bridge,
+  forwards the reports of those states only, and a report that does not
+  follow a sample of this sampler is ignored.
+
+  The memory is fixed by the number of bins, and a sample or an update
+  costs constant time.
+
+  \ingroup samplers
+*/
+template <class State, int NUM_DIMENSIONS> class Adaptive : public Base<State> {
+
+  using region_t = Region<NUM_DIMENSIONS>;
+
+  Base<State> &sampler;
+
+  region_t support;
+
+  double bin_size{1.0};
+  int num_bins_x{1};
+  int num_bins_y{1};
+
+  // Discounted number of samples and sum of their rewards of every bin, as
+  // of the update it was last changed at.
+  std::vector<double> counts;
+  std::vector<double> rewards;
+  std::vector<uint64_t> last_updates;
+
+  uint64_t num_updates{0};
+
+  double weight_floor{0.3};
+
+  // Number of updates over which a reward is discounted by a factor e, and
+  // the discount per update.
+  double memory{10000.0};
+  double discount{exp(-1.0 / 10000.0)};
+
+  // Draws from the other sampler before a state is accepted anyway.
+  int max_attempts{100};
+
+  Xoshiro256PlusPlus generator;
+
+  unsigned long num_samples{0};
+  unsigned long num_rejections{0};
+
+  // Whether the last sample was drawn by this sampler and not reported yet.
+  bool has_sample{false};
+
+  int get_bin(State *state_in) {
+
+    int bin_x = (int)floor(((*state_in)[0] - support.center[0] +
+                            support.size[0] / 2.0) /
+                           bin_size);
+    bin_x = std::min(std::max(bin_x, 0), num_bins_x - 1);
+    if (NUM_DIMENSIONS < 2)
+      return bin_x;
+
+    int bin_y = (int)floor(((*state_in)[1] - support.center[1] +
+                            support.size[1] / 2.0) /
+                           bin_size);
+    bin_y = std::min(std::max(bin_y, 0), num_bins_y - 1);
+
+    return bin_y * num_bins_x + bin_x;
+  }
+
+  // Discounts the rewards of a bin to the current update.
+  void discount_bin(int bin) {
+    double factor = pow(discount, (double)(num_updates - last_updates[bin]));
+    counts[bin] *= factor;
+    rewards[bin] *= factor;
+    last_updates[bin] = num_updates;
+  }
+
+  double get_weight(int bin) {
+    discount_bin(bin);
+    double average = (rewards[bin] + 1.0) / (counts[bin] + 1.0);
+    return weight_floor + (1.0 - weight_floor) * average;
+  }
+
+public:
+  /**
+   * \brief Constructor that sets the sampler the states are drawn from.
+   *
+   * @param sampler_in The sampler that states are drawn from.
+   */
+  Adaptive(Base<State> &sampler_in) : sampler(sampler_in) {
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      support.center[i] = 0.0;
+      support.size[i] = 1.0;
+    }
+    reset();
+  }
+
+  ~Adaptive() {}
+
+  int sample(State **state_sample_out) {
+
+    State *state_new = new State;
+    int result = sample_into(state_new);
+    *state_sample_out = state_new;
+
+    return result;
+  }
+
+  int sample_into(State *state_sample_out) {
+
+    for (int i = 0;; i++) {
+      int result = sampler.sample_into(state_sample_out);
+      if (result <= 0)
+        return result;
+      num_samples++;
+
+      if ((i >= max_attempts) ||
+          (generator.next_double() < get_weight(get_bin(state_sample_out)))) {
+        has_sample = true;
+        return 1;
+      }
+
+      num_rejections++;
+    }
+  }
+
+  int update(State *state_in, double reward) {
+
+    if (!has_sample)
+      return 1;
+    has_sample = false;
+
+    num_updates++;
+
+    int bin = get_bin(state_in);
+    discount_bin(bin);
+    counts[bin] += 1.0;
+    rewards[bin] += reward;
+
+    return sampler.update(state_in, reward);
+  }
+
+  /**
+   * \brief Forgets the rewards of all bins.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int reset() {
+
+    int num_bins = num_bins_x * num_bins_y;
+    counts.assign(num_bins, 0.0);
+    rewards.assign(num_bins, 0.0);
+    last_updates.assign(num_bins, 0);
+    num_updates = 0;
+    num_samples = 0;
+    num_rejections = 0;
+    has_sample = false;
+
+    return 1;
+  }
+
+  /**
+   * \brief Sets the seed of the pseudo-random number generator.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_seed(uint64_t seed) {
+    generator.seed(seed);
+    return 1;
+  }
+
+  /**
+   * \brief Sets the support that is divided into bins, and the side of a bin.
+   *
+   * Only the first two dimensions of the support are used. If the support
+   * needs more than ADAPTIVE_MAX_BINS bins, the bins are enlarged. Forgets
+   * the rewards of all bins.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_support(const region_t support_in, double bin_size_in) {
+
+    if (!(bin_size_in > 0.0))
+      return 0;
+
+    support = support_in;
+    bin_size = bin_size_in;
+
+    while (true) {
+      num_bins_x = std::max(1, (int)ceil(support.size[0] / bin_size));
+      num_bins_y = (NUM_DIMENSIONS < 2)
+                       ? 1
+                       : std::max(1, (int)ceil(support.size[1] / bin_size));
+      if ((double)num_bins_x * num_bins_y <= ADAPTIVE_MAX_BINS)
+        break;
+      bin_size *= 2.0;
+    }
+
+    return reset();
+  }
+
+  /**
+   * \brief Sets the smallest weight of a bin, which is the smallest
+   * probability that a state drawn from the other sampler is accepted.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_weight_floor(double weight_floor_in) {
+    if (!(weight_floor_in > 0.0) || (weight_floor_in > 1.0))
+      return 0;
+    weight_floor = weight_floor_in;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the number of updates over which a reward is discounted by a
+   * factor e.
+   *
+   * A shorter memory adapts faster to the growth of the tree.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_memory(double memory_in) {
+    if (!(memory_in > 0.0))
+      return 0;
+    memory = memory_in;
+    discount = exp(-1.0 / memory);
+    return 1;
+  }
+
+  inline double get_bin_size() const { return bin_size; }
+  inline unsigned long get_num_samples() const { return num_samples; }
+  inline unsigned long get_num_rejections() const { return num_rejections; }
+};
+} // namespace samplers
+} // namespace smp
@@ -0,0 +1,87 @@
+/*! \file components/samplers/alias_table.h
+  \brief Constant-time sampling from a discrete distribution
+
+  This file implements the alias method of Walker, built with the algorithm of
+  Vose, for drawing indices from a discrete probability distribution in
+  constant time.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <vector>
+
+namespace smp {
+namespace samplers {
+
+//! Alias table for a discrete probability distribution.
+/*!
+  Every entry i of the table holds a probability and an alias. An index is
+  drawn by picking an entry uniformly at random, and then returning either
+  the entry itself, with its probability, or its alias.
+
+  \ingroup samplers
+*/
+class AliasTable {
+
+  std::vector<double> probability;
+  std::vector<int> alias;
+
+  // Scratch buffers for the construction.
+  std::vector<double> scaled;
+  std::vector<int> small;
+  std::vector<int> large;
+
+public:
+  AliasTable();
+  ~AliasTable();
+
+  /**
+   * \brief Builds the table for the given weights.
+   *
+   * The weights do not need to be normalized.
+   *
+   * @param weights Array of num_weights non-negative weights.
+   * @param num_weights Number of weights.
+   *
+   * @returns Returns 1 for success, a non-positive number if the weights do
+   *          not sum to a positive number.
+   */
+  int build(const double *weights, int num_weights);
+
+  /**
+   * \brief Builds the table for the uniform distribution over num_entries.
+   */
+  void build_uniform(int num_entries);
+
+  /**
+   * \brief Draws an index from two numbers uniformly distributed in [0, 1).
+   */
+  inline int sample(double u_entry, double u_alias) const {
+    int num_entries = (int)probability.size();
+    int entry = (int)(u_entry * num_entries);
+    if (entry >= num_entries)
+      entry = num_entries - 1;
+    return (u_alias < probability[entry]) ? entry : alias[entry];
+  }
+
+  inline int size() const { return (int)probability.size(); }
+  inline bool empty() const { return probability.empty(); }
+};
+} // namespace samplers
+} // namespace smp
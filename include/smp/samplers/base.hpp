@@ -23,6 +23,8 @@
 
 #include <smp/vertex_edge.hpp>
 
+#include <cstddef>
+
 namespace smp {
 namespace samplers {
 
@@ -52,6 +54,46 @@ public:
    * @returns Returns 1 for success, a non-positive number for failure.
    */
   virtual int sample(State **state_sample_out) = 0;
+
+  /**
+   * \brief Writes a sample state into storage provided by the caller.
+   *
+   * Samplers that can generate a sample without allocating memory should
+   * override this function. The default implementation calls sample() and
+   * copies the new state.
+   *
+   * @param state_sample_out The state that the sample is written to.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  virtual int sample_into(State *state_sample_out) {
+    State *state_new = NULL;
+    int result = sample(&state_new);
+    if (state_new) {
+      if (result > 0)
+        *state_sample_out = *state_new;
+      delete state_new;
+    }
+    return result;
+  }
+
+  /**
+   * \brief Reports how useful a sample turned out to be for the planner.
+   *
+   * The planner calls this function once per sample, after the iteration
+   * that used it. Samplers that adapt their distribution should override
+   * this function, and samplers that draw from another sampler should
+   * forward the report to it if that sampler drew the state. The default
+   * implementation ignores it.
+   *
+   * @param state_in The sample state.
+   * @param reward A number in [0, 1]: 0 if the sample did not add a vertex,
+   *               0.5 if it added one, and 1 if the new vertex also lowered
+   *               the cost of existing vertices.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  virtual int update(State * /*state_in*/, double /*reward*/) { return 1; }
 };
 } // namespace samplers
 } // namespace smp
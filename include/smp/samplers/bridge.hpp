@@ -0,0 +1,409 @@
+/*! \file components/samplers/bridge.h
+  \brief A sampler that concentrates samples in narrow passages
+
+  The sampler finds free states close to obstacles with the bridge test or
+  the Gaussian test, and mixes them with unbiased samples.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <smp/collision_checkers/base.hpp>
+#include <smp/region.hpp>
+#include <smp/samplers/base.hpp>
+#include <smp/samplers/random.hpp>
+
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smp {
+namespace samplers {
+
+//! Implements narrow passage sampling with the bridge or the Gaussian test.
+/*!
+  A candidate is found by drawing a state x uniformly from the support and a
+  state y around it, with independent normal offsets along every axis.
+
+  - Bridge test: if both x and y are in collision and their midpoint is free,
+    the midpoint is a candidate. Such midpoints lie in passages narrower than
+    the offsets.
+  - Gaussian test: if exactly one of x and y is in collision, the free one is
+    a candidate. Such states lie close to the obstacle boundaries.
+
+  Every sample is a candidate with the mix ratio probability, and an unbiased
+  sample otherwise. The unbiased samples are drawn uniformly from the support
+  or, if the sampler is constructed with another sampler, from that sampler.
+
+  Candidates usually take many collision checks to find. Once start() is
+  called, a background thread finds them and stores them in a buffer, so
+  that the planning thread only pops them; if the buffer is empty, an
+  unbiased sample is returned instead. The background thread calls
+  check_collision() on single states concurrently with the planner, which
+  the collision checker must allow (MultipleCirclesCostmap does, as long as
+  its map is not modified). Call stop() before modifying the map of the
+  collision checker. Without the background thread, candidates are searched
+  for on the calling thread.
+
+  \ingroup samplers
+*/
+template <class State, int NUM_DIMENSIONS> class Bridge : public Base<State> {
+
+  using region_t = Region<NUM_DIMENSIONS>;
+
+public:
+  //! The test used to find candidates.
+  enum test_t { bridge_test, gaussian_test };
+
+private:
+  collision_checkers::Base<State> &collision_checker;
+
+  // The sampler for the unbiased samples, or NULL to sample the support.
+  Base<State> *sampler;
+
+  // Whether the last sample was drawn by the other sampler, which is then
+  // the one that its report belongs to.
+  bool sampled_by_sampler{false};
+
+  region_t support;
+
+  test_t test{bridge_test};
+
+  double deviation[NUM_DIMENSIONS];
+
+  double mix_ratio{0.5};
+
+  // Number of pairs tested before a search on the calling thread gives up.
+  int max_attempts{100};
+
+  // Generators of the calling thread and of the background thread.
+  Xoshiro256PlusPlus generator;
+  Xoshiro256PlusPlus generator_background;
+
+  // Ring buffer of the candidates found by the background thread.
+  std::vector<State> buffer;
+  int buffer_begin{0};
+  int buffer_count{0};
+  std::mutex buffer_mutex;
+  std::condition_variable buffer_not_full;
+
+  std::thread thread_background;
+  bool running{false};
+
+  unsigned long num_candidates{0};
+  unsigned long num_buffer_misses{0};
+
+  // Draws a number from the standard normal distribution.
+  static double next_normal(Xoshiro256PlusPlus &rng) {
+    double u1 = 1.0 - rng.next_double();
+    double u2 = rng.next_double();
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+  }
+
+  // Tests one pair of states. Returns 1 and writes the candidate if the test
+  // succeeds, 0 otherwise.
+  int test_pair(Xoshiro256PlusPlus &rng, State *state_out) {
+
+    State state_first, state_second;
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      state_first[i] = support.size[i] * rng.next_double() -
+                       support.size[i] / 2.0 + support.center[i];
+      state_second[i] = state_first[i] + deviation[i] * next_normal(rng);
+    }
+
+    int free_first = collision_checker.check_collision(&state_first);
+
+    if (test == gaussian_test) {
+      int free_second = collision_checker.check_collision(&state_second);
+      if (free_first == free_second)
+        return 0;
+      *state_out = free_first ? state_first : state_second;
+      return 1;
+    }
+
+    if (free_first || collision_checker.check_collision(&state_second))
+      return 0;
+
+    for (int i = 0; i < NUM_DIMENSIONS; i++)
+      (*state_out)[i] = (state_first[i] + state_second[i]) / 2.0;
+
+    return collision_checker.check_collision(state_out) ? 1 : 0;
+  }
+
+  void run_background() {
+
+    State candidate;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(buffer_mutex);
+        buffer_not_full.wait(lock, [this]() {
+          return !running || (buffer_count < (int)buffer.size());
+        });
+        if (!running)
+          return;
+      }
+
+      if (test_pair(generator_background, &candidate) == 0)
+        continue;
+
+      std::lock_guard<std::mutex> lock(buffer_mutex);
+      int index = (buffer_begin + buffer_count) % (int)buffer.size();
+      buffer[index] = candidate;
+      buffer_count++;
+    }
+  }
+
+  // Pops a candidate from the buffer, or searches for one on the calling
+  // thread if the background thread is not running.
+  int get_candidate(State *state_out) {
+
+    {
+      std::lock_guard<std::mutex> lock(buffer_mutex);
+      if (running) {
+        if (buffer_count == 0) {
+          num_buffer_misses++;
+          return 0;
+        }
+        *state_out = buffer[buffer_begin];
+        buffer_begin = (buffer_begin + 1) % (int)buffer.size();
+        buffer_count--;
+        buffer_not_full.notify_one();
+        return 1;
+      }
+    }
+
+    for (int k = 0; k < max_attempts; k++)
+      if (test_pair(generator, state_out))
+        return 1;
+
+    return 0;
+  }
+
+public:
+  /**
+   * \brief Constructor for a sampler whose unbiased samples are uniform.
+   *
+   * @param collision_checker_in The collision checker the tests use.
+   */
+  Bridge(collision_checkers::Base<State> &collision_checker_in)
+      : collision_checker(collision_checker_in), sampler(NULL) {
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      support.center[i] = 0.0;
+      support.size[i] = 1.0;
+      deviation[i] = 0.5;
+    }
+    buffer.resize(256);
+    generator_background.jump();
+  }
+
+  /**
+   * \brief Constructor for a sampler whose unbiased samples are drawn from
+   * another sampler.
+   *
+   * @param collision_checker_in The collision checker the tests use.
+   * @param sampler_in The sampler for the unbiased samples.
+   */
+  Bridge(collision_checkers::Base<State> &collision_checker_in,
+         Base<State> &sampler_in)
+      : Bridge(collision_checker_in) {
+    sampler = &sampler_in;
+  }
+
+  ~Bridge() { stop(); }
+
+  /**
+   * \brief Starts the background thread that fills the candidate buffer.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int start() {
+
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    if (running)
+      return 1;
+
+    buffer_begin = 0;
+    buffer_count = 0;
+    running = true;
+    thread_background = std::thread(&Bridge::run_background, this);
+
+    return 1;
+  }
+
+  /**
+   * \brief Stops the background thread and empties the candidate buffer.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int stop() {
+
+    {
+      std::lock_guard<std::mutex> lock(buffer_mutex);
+      if (!running)
+        return 1;
+      running = false;
+      buffer_count = 0;
+    }
+    buffer_not_full.notify_all();
+    thread_background.join();
+
+    return 1;
+  }
+
+  int sample(State **state_sample_out) {
+
+    State *state_new = new State;
+    int result = sample_into(state_new);
+    *state_sample_out = state_new;
+
+    return result;
+  }
+
+  int sample_into(State *state_sample_out) {
+
+    sampled_by_sampler = false;
+    if (NUM_DIMENSIONS <= 0)
+      return 0;
+
+    if (generator.next_double() < mix_ratio) {
+      if (get_candidate(state_sample_out)) {
+        num_candidates++;
+        return 1;
+      }
+    }
+
+    if (sampler) {
+      sampled_by_sampler = true;
+      return sampler->sample_into(state_sample_out);
+    }
+
+    for (int i = 0; i < NUM_DIMENSIONS; i++)
+      (*state_sample_out)[i] = support.size[i] * generator.next_double() -
+                               support.size[i] / 2.0 + support.center[i];
+
+    return 1;
+  }
+
+  int update(State *state_in, double reward) {
+    return sampled_by_sampler ? sampler->update(state_in, reward) : 1;
+  }
+
+  /**
+   * \brief Sets the seeds of the pseudo-random number generators.
+   *
+   * Must not be called while the background thread is running.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_seed(uint64_t seed) {
+    generator.seed(seed);
+    generator_background.seed(seed);
+    generator_background.jump();
+    return 1;
+  }
+
+  /**
+   * \brief Sets the support that the first state of every pair is drawn from.
+   *
+   * Must not be called while the background thread is running.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_support(const region_t support_in) {
+    support = support_in;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the test used to find candidates.
+   *
+   * Must not be called while the background thread is running.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_test(test_t test_in) {
+    test = test_in;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the standard deviation of the offset between the states of
+   * a pair along one axis.
+   *
+   * The deviation should be about the width of the passages of interest. A
+   * deviation of zero keeps the axis fixed, e.g., the heading of a robot.
+   * Must not be called while the background thread is running.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_deviation(int dimension, double deviation_in) {
+    if ((dimension < 0) || (dimension >= NUM_DIMENSIONS) ||
+        (deviation_in < 0.0))
+      return 0;
+    deviation[dimension] = deviation_in;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the probability that a sample is a candidate of the test.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_mix_ratio(double mix_ratio_in) {
+    if ((mix_ratio_in < 0.0) || (mix_ratio_in > 1.0))
+      return 0;
+    mix_ratio = mix_ratio_in;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the number of candidates the background thread keeps ready.
+   *
+   * Must not be called while the background thread is running.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_buffer_size(int buffer_size) {
+    if (buffer_size <= 0)
+      return 0;
+    buffer.resize(buffer_size);
+    return 1;
+  }
+
+  /**
+   * \brief Sets the number of pairs tested by a search on the calling thread.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_max_attempts(int max_attempts_in) {
+    if (max_attempts_in <= 0)
+      return 0;
+    max_attempts = max_attempts_in;
+    return 1;
+  }
+
+  inline unsigned long get_num_candidates() const { return num_candidates; }
+  inline unsigned long get_num_buffer_misses() const {
+    return num_buffer_misses;
+  }
+};
+} // namespace samplers
+} // namespace smp
@@ -0,0 +1,213 @@
+/*! \file components/samplers/free_space.h
+  \brief A sampler that draws positions from the free cells of a grid map
+
+  The sampler provides random samples of states whose positions lie in the
+  free cells of a 2D grid map.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <smp/region.hpp>
+#include <smp/samplers/alias_table.hpp>
+#include <smp/samplers/base.hpp>
+#include <smp/samplers/random.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace smp {
+namespace samplers {
+
+//! Implements a sampler that draws positions from the free cells of a map.
+/*!
+  The first two state variables are the position. The sampler keeps an index
+  of the free cells of a 2D grid map and an alias table over them, so that a
+  cell is drawn in constant time, uniformly or in proportion to per-cell
+  weights. The position is then drawn uniformly within the cell. The other
+  state variables are drawn uniformly from the support. With a given
+  probability, the sample is drawn uniformly from the goal region instead.
+
+  The bounds of the positions come from the map: the support is only used for
+  the state variables after the position.
+
+  \ingroup samplers
+*/
+template <class State, int NUM_DIMENSIONS> class FreeSpace : public Base<State> {
+
+  using region_t = Region<NUM_DIMENSIONS>;
+
+  region_t support;
+
+  region_t goal_region;
+
+  double goal_bias{0.0};
+
+  double resolution{0.05};
+  double origin_x{0.0};
+  double origin_y{0.0};
+  int size_x{0};
+
+  // Row-major indices of the free cells, and the table to draw them from.
+  std::vector<int> free_cells;
+  AliasTable alias_table;
+
+  Xoshiro256PlusPlus generator;
+
+public:
+  FreeSpace() {
+    // Initialize the sampling distribution support.
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      support.center[i] = 0.0;
+      support.size[i] = 1.0;
+    }
+  }
+
+  ~FreeSpace() {}
+
+  /**
+   * \brief Sets the free cells of the map.
+   *
+   * @param free_mask Row-major array of size_x_in * size_y_in bytes,
+   *                  non-zero for free cells.
+   * @param size_x_in Number of cells along the x axis.
+   * @param size_y_in Number of cells along the y axis.
+   * @param resolution_in Size of a cell in meters.
+   * @param origin_x_in World x coordinate of the lower-left map corner.
+   * @param origin_y_in World y coordinate of the lower-left map corner.
+   * @param weights Optional row-major array of non-negative cell weights.
+   *                If NULL, all free cells are equally likely.
+   *
+   * @returns Returns 1 for success, a non-positive number if no cell can
+   *          be drawn.
+   */
+  int set_map(const unsigned char *free_mask, int size_x_in, int size_y_in,
+              double resolution_in, double origin_x_in, double origin_y_in,
+              const double *weights = NULL) {
+
+    size_x = size_x_in;
+    resolution = resolution_in;
+    origin_x = origin_x_in;
+    origin_y = origin_y_in;
+
+    free_cells.clear();
+    for (int index = 0; index < size_x_in * size_y_in; index++) {
+      if (free_mask[index])
+        free_cells.push_back(index);
+    }
+
+    if (free_cells.empty()) {
+      std::cerr << "[set_map]: NO FREE CELLS!\n";
+      alias_table.build_uniform(0);
+      return 0;
+    }
+
+    if (weights == NULL) {
+      alias_table.build_uniform((int)free_cells.size());
+      return 1;
+    }
+
+    std::vector<double> free_weights(free_cells.size());
+    for (size_t i = 0; i < free_cells.size(); i++)
+      free_weights[i] = weights[free_cells[i]];
+    return alias_table.build(free_weights.data(), (int)free_weights.size());
+  }
+
+  int set_goal_bias(double bias, const Region<NUM_DIMENSIONS> &region_goal) {
+    this->goal_bias = bias;
+    this->goal_region = region_goal;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the seed of the pseudo-random number generator.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_seed(uint64_t seed) {
+    generator.seed(seed);
+    return 1;
+  }
+
+  int sample(State **state_sample_out) {
+
+    State *state_new = new State;
+    int result = sample_into(state_new);
+    *state_sample_out = state_new;
+
+    return result;
+  }
+
+  int sample_into(State *state_sample_out) {
+
+    if (NUM_DIMENSIONS < 2) {
+      return 0;
+    }
+
+    if (goal_bias > generator.next_double()) {
+      for (int i = 0; i < NUM_DIMENSIONS; i++)
+        (*state_sample_out)[i] = goal_region.size[i] * generator.next_double() -
+                                 goal_region.size[i] / 2.0 +
+                                 goal_region.center[i];
+      return 1;
+    }
+
+    if (alias_table.empty()) {
+      std::cerr << "[sample_into]: NO FREE CELLS!\n";
+      return 0;
+    }
+
+    double u_entry = generator.next_double();
+    double u_alias = generator.next_double();
+    int cell = free_cells[alias_table.sample(u_entry, u_alias)];
+
+    // Jitter the position uniformly within the cell.
+    (*state_sample_out)[0] =
+        origin_x + (cell % size_x + generator.next_double()) * resolution;
+    (*state_sample_out)[1] =
+        origin_y + (cell / size_x + generator.next_double()) * resolution;
+
+    for (int i = 2; i < NUM_DIMENSIONS; i++)
+      (*state_sample_out)[i] = support.size[i] * generator.next_double() -
+                               support.size[i] / 2.0 + support.center[i];
+
+    return 1;
+  }
+
+  /**
+   * \brief Sets the support of the state variables after the position.
+   *
+   * The first two dimensions of the support are ignored, since the
+   * positions are drawn from the free cells of the map.
+   *
+   * @param support_in New support for the sampling distribution.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_support(const region_t support_in) {
+
+    support = support_in;
+
+    return 1;
+  }
+
+  inline int get_num_free_cells() const { return (int)free_cells.size(); }
+};
+} // namespace samplers
+} // namespace smp
@@ -24,15 +24,20 @@
 
 #pragma once
 
-#include <smp/external_libraries/halton/halton.h>
 #include <smp/region.hpp>
 #include <smp/samplers/base.hpp>
+#include <smp/samplers/halton_sequence.hpp>
+
+#include <cstdint>
 
 namespace smp {
 namespace samplers {
 //! Implements the sampler components that relies on halton sampling.
 /*!
-  A sampler component that implements halton sampling.
+  A sampler component that implements halton sampling. Every instance owns
+  its sequence, so several samplers can be used in the same process, and
+  parallel workers can each draw from their own leapfrogged stream of the
+  same sequence (see HaltonSequence).
 
   \ingroup samplers
 */
@@ -42,6 +47,8 @@ template <class State, int NUM_DIMENSIONS> class Halton : public Base<State> {
 
   region_t support;
 
+  HaltonSequence sequence;
+
 public:
   Halton() {
     // Initialize the sampling distribution support.
@@ -51,7 +58,7 @@ public:
     }
 
     // Initialize the halton sequence dimension
-    halton_dim_num_set(NUM_DIMENSIONS);
+    sequence.set_dimensions(NUM_DIMENSIONS);
   }
 
   ~Halton() {}
@@ -62,21 +69,56 @@ public:
       return 0;
 
     State *state_new = new State;
+    sample_into(state_new);
+    *state_sample_out = state_new;
+
+    return 1;
+  }
+
+  int sample_into(State *state_sample_out) {
+
+    if (NUM_DIMENSIONS <= 0)
+      return 0;
 
     double halton_sample[NUM_DIMENSIONS];
 
-    halton(halton_sample);
+    sequence.next(halton_sample);
 
-    // Generate an independent random variable for each axis.
+    // Scale each coordinate of the point to the support.
     for (int i = 0; i < NUM_DIMENSIONS; i++)
-      (*state_new)[i] = support.size[i] * halton_sample[i] -
-                        support.size[i] / 2.0 + support.center[i];
-
-    *state_sample_out = state_new;
+      (*state_sample_out)[i] = support.size[i] * halton_sample[i] -
+                               support.size[i] / 2.0 + support.center[i];
 
     return 1;
   }
 
+  /**
+   * \brief Scrambles the digits of the sequence with the given seed.
+   *
+   * Samplers with the same seed produce the same samples. Restarts the
+   * sequence, so this function must be called before set_stream().
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_scrambling(uint64_t seed) {
+    return sequence.set_scrambling(true, seed);
+  }
+
+  /**
+   * \brief Makes the sampler draw from the stream of one of several workers.
+   *
+   * Samplers of different workers with the same scrambling draw disjoint
+   * subsequences of the same sequence.
+   *
+   * @param worker Index of the worker, in [0, num_workers).
+   * @param num_workers Number of workers sharing the sequence.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_stream(int worker, int num_workers) {
+    return sequence.set_stream(worker, num_workers);
+  }
+
   /**
    * \brief Sets the dimensions and position of the rectangular bounding box of
    *        the support.
@@ -0,0 +1,142 @@
+/*! \file components/samplers/halton_sequence.h
+  \brief A reentrant generator of (scrambled) Halton sequences
+
+  This file implements a Halton sequence generator whose state is owned by
+  each instance, so that several sequences can be used at the same time, e.g.,
+  by several planners or by several worker threads.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace smp {
+namespace samplers {
+
+//! Reentrant Halton sequence generator.
+/*!
+  The i-th coordinate of the n-th point is the radical inverse of n in the
+  i-th prime base. The radical inverse is evaluated with precomputed tables,
+  each covering a block of base digits, so that a coordinate costs a few table
+  lookups instead of a loop over all digits.
+
+  The sequence can be scrambled by applying a random permutation to the
+  digits at every digit position, which removes the correlation between the
+  coordinates of large prime bases while keeping the low discrepancy of the
+  sequence.
+
+  Independent streams for parallel workers are obtained by leapfrogging:
+  worker w out of W uses the points w, w + L, w + 2L, ... of the sequence,
+  where the stride L is a prime that is at least W and is not one of the
+  bases of the sequence.
+
+  \ingroup samplers
+*/
+class HaltonSequence {
+
+  int num_dimensions;
+
+  std::vector<int> bases;
+
+  // Number of base digits covered by one block of a table, the size of a
+  // block, the number of blocks and the total number of digits per
+  // dimension.
+  std::vector<int> block_digits;
+  std::vector<uint64_t> block_sizes;
+  std::vector<int> num_blocks;
+  std::vector<int> num_digits;
+
+  // Digit permutations of every digit position of every dimension.
+  std::vector<std::vector<std::vector<int>>> permutations;
+
+  // Radical inverse tables of every dimension, block after block.
+  std::vector<std::vector<double>> tables;
+
+  // Contribution of the digit positions beyond the tables, for indices that
+  // the tables cover entirely.
+  std::vector<double> tails;
+
+  bool scrambled;
+  uint64_t scrambling_seed;
+
+  uint64_t index;
+  uint64_t stride;
+
+  void build_tables();
+
+public:
+  HaltonSequence();
+  ~HaltonSequence();
+
+  /**
+   * \brief Sets the number of dimensions of the sequence.
+   *
+   * Resets the sequence to its first point.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_dimensions(int num_dimensions_in);
+
+  /**
+   * \brief Enables or disables the scrambling of the digits.
+   *
+   * The digit permutations are drawn from the given seed, so sequences with
+   * the same seed are identical. Resets the sequence to its first point.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_scrambling(bool scrambled_in, uint64_t seed = 0);
+
+  /**
+   * \brief Selects the leapfrogged stream of a worker.
+   *
+   * @param worker Index of the worker, in [0, num_workers).
+   * @param num_workers Number of workers sharing the sequence.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_stream(int worker, int num_workers);
+
+  /**
+   * \brief Sets the index of the next point of the sequence.
+   */
+  inline void set_index(uint64_t index_in) { index = index_in; }
+
+  inline uint64_t get_index() const { return index; }
+  inline uint64_t get_stride() const { return stride; }
+  inline int get_num_dimensions() const { return num_dimensions; }
+  inline int get_base(int dimension) const { return bases[dimension]; }
+
+  /**
+   * \brief Returns the (scrambled) radical inverse of n for a dimension.
+   *
+   * @returns Returns a number in [0, 1).
+   */
+  double radical_inverse(int dimension, uint64_t n) const;
+
+  /**
+   * \brief Writes the next point of the stream and advances the index.
+   *
+   * @param point_out Array of num_dimensions numbers in [0, 1).
+   */
+  void next(double *point_out);
+};
+} // namespace samplers
+} // namespace smp
@@ -0,0 +1,219 @@
+/*! \file components/samplers/informed.h
+  \brief A sampler that rejects states which cannot improve the solution
+
+  The sampler draws states from another sampler, and once a solution is
+  known, rejects the states through which no trajectory can be cheaper.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <smp/extenders/base.hpp>
+#include <smp/region.hpp>
+#include <smp/samplers/base.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace smp {
+namespace samplers {
+
+//! Implements informed sampling on top of another sampler.
+/*!
+  Once the planner has found a trajectory to the goal region, only the states
+  x with
+
+    cost_lower_bound(root, x) + cost_lower_bound(x, goal) < best cost
+
+  can be on a cheaper trajectory, where the lower bounds are provided by the
+  extender. This sampler draws states from another sampler and rejects the
+  ones that violate this condition, so that the planner spends its
+  iterations on the part of the space that can still improve the solution.
+  Before the first solution, every state is accepted.
+
+  The cost to the goal is bounded with the state of the goal region that is
+  closest to x along every coordinate. This is exact for lower bounds that
+  grow with the differences between the coordinates of the states, such as
+  the position-based bounds of the Dubins and PosQ extenders; for other
+  extenders the rejection is only a heuristic.
+
+  A tighter bound on the cost to the goal, e.g., one that accounts for the
+  obstacles, can be set with set_cost_to_go_function(). The larger of the
+  two bounds is used.
+
+  To keep the planner running when the informed set is a small part of the
+  support of the other sampler, the last state drawn is accepted after a
+  maximum number of rejections.
+
+  \ingroup samplers
+*/
+template <class State, class Input, int NUM_DIMENSIONS>
+class Informed : public Base<State> {
+
+  using region_t = Region<NUM_DIMENSIONS>;
+  using best_cost_function_t = std::function<double()>;
+  using cost_to_go_function_t = std::function<double(State *)>;
+
+  Base<State> &sampler;
+  extenders::Base<State, Input> &extender;
+
+  State state_root;
+  bool has_root{false};
+
+  region_t region_goal;
+
+  best_cost_function_t best_cost_function;
+
+  cost_to_go_function_t cost_to_go_function;
+
+  int max_rejections{100};
+
+  unsigned long num_samples{0};
+  unsigned long num_rejections{0};
+
+public:
+  /**
+   * \brief Constructor that sets the underlying sampler and the extender.
+   *
+   * @param sampler_in The sampler that states are drawn from.
+   * @param extender_in The extender that provides the cost lower bounds.
+   */
+  Informed(Base<State> &sampler_in, extenders::Base<State, Input> &extender_in)
+      : sampler(sampler_in), extender(extender_in) {}
+
+  ~Informed() {}
+
+  /**
+   * \brief Sets the root state of the tree.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_root(State *state_root_in) {
+    state_root = *state_root_in;
+    has_root = true;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the goal region.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_goal_region(const region_t &region_goal_in) {
+    region_goal = region_goal_in;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the function that returns the cost of the best solution.
+   *
+   * The function must return a negative number if no solution is known,
+   * e.g., MinimumTimeReachability::get_best_cost().
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_best_cost_function(best_cost_function_t function) {
+    best_cost_function = function;
+    return 1;
+  }
+
+  /**
+   * \brief Sets a function that bounds the cost from a state to the goal
+   * region from below.
+   *
+   * The function may return infinity for states that cannot reach the goal
+   * region. An empty function disables the bound.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_cost_to_go_function(cost_to_go_function_t function) {
+    cost_to_go_function = function;
+    return 1;
+  }
+
+  /**
+   * \brief Sets the number of states rejected before one is accepted anyway.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_max_rejections(int max_rejections_in) {
+    if (max_rejections_in < 0)
+      return 0;
+    max_rejections = max_rejections_in;
+    return 1;
+  }
+
+  /**
+   * \brief Returns a lower bound on the cost of a trajectory from the root
+   * to the goal region through the given state.
+   */
+  double cost_lower_bound_through(State *state_in) {
+
+    // MinimumTimeReachability accepts the states within the size of the goal
+    // region from its center along every coordinate.
+    State state_goal;
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      double lower = region_goal.center[i] - region_goal.size[i];
+      double upper = region_goal.center[i] + region_goal.size[i];
+      double value = (*state_in)[i];
+      state_goal[i] = (value < lower) ? lower : (value > upper) ? upper : value;
+    }
+
+    double cost_to_go = extender.cost_lower_bound(state_in, &state_goal);
+    if (cost_to_go_function)
+      cost_to_go = std::max(cost_to_go, cost_to_go_function(state_in));
+
+    return extender.cost_lower_bound(&state_root, state_in) + cost_to_go;
+  }
+
+  int sample(State **state_sample_out) {
+
+    State *state_new = new State;
+    int result = sample_into(state_new);
+    *state_sample_out = state_new;
+
+    return result;
+  }
+
+  int sample_into(State *state_sample_out) {
+
+    double best_cost = best_cost_function ? best_cost_function() : -1.0;
+
+    for (int i = 0;; i++) {
+      int result = sampler.sample_into(state_sample_out);
+      if (result <= 0)
+        return result;
+      num_samples++;
+
+      if ((best_cost < 0.0) || !has_root || (i >= max_rejections) ||
+          (cost_lower_bound_through(state_sample_out) < best_cost))
+        return 1;
+
+      num_rejections++;
+    }
+  }
+
+  int update(State *state_in, double reward) {
+    return sampler.update(state_in, reward);
+  }
+
+  inline unsigned long get_num_samples() const { return num_samples; }
+  inline unsigned long get_num_rejections() const { return num_rejections; }
+};
+} // namespace samplers
+} // namespace smp
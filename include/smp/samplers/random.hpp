@@ -0,0 +1,218 @@
+/*! \file components/samplers/random.h
+  \brief Pseudo-random number generators for the samplers
+
+  This file implements the xoshiro256++ pseudo-random number generator of
+  Blackman and Vigna, both as a single stream and as four interleaved streams
+  that are advanced together.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace smp {
+namespace samplers {
+
+//! The xoshiro256++ pseudo-random number generator.
+/*!
+  A fast generator with 256 bits of state and a period of 2^256 - 1. Every
+  instance owns its state, so instances can be used from different threads
+  without locking. The state is initialized from a 64-bit seed with the
+  splitmix64 generator, as recommended by the authors.
+
+  \ingroup samplers
+*/
+class Xoshiro256PlusPlus {
+
+  uint64_t s[4];
+
+  static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+public:
+  explicit Xoshiro256PlusPlus(uint64_t seed_in = 0x5DEECE66DULL) {
+    seed(seed_in);
+  }
+
+  /**
+   * \brief Resets the state of the generator from a 64-bit seed.
+   */
+  void seed(uint64_t seed_in) {
+    for (int i = 0; i < 4; i++) {
+      // splitmix64
+      seed_in += 0x9E3779B97F4A7C15ULL;
+      uint64_t z = seed_in;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      s[i] = z ^ (z >> 31);
+    }
+  }
+
+  /**
+   * \brief Returns the next 64 random bits.
+   */
+  inline uint64_t next() {
+    const uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+  }
+
+  /**
+   * \brief Returns a random number uniformly distributed in [0, 1).
+   */
+  inline double next_double() {
+    return (next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  /**
+   * \brief Advances the generator by 2^128 steps.
+   *
+   * Calling jump() on copies of a generator gives non-overlapping streams.
+   */
+  void jump() {
+    static const uint64_t jump_polynomial[4] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL,
+        0x39ABDC4529B1661CULL};
+
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+      for (int b = 0; b < 64; b++) {
+        if (jump_polynomial[i] & ((uint64_t)1 << b)) {
+          for (int j = 0; j < 4; j++)
+            t[j] ^= s[j];
+        }
+        next();
+      }
+    }
+    memcpy(s, t, sizeof(s));
+  }
+
+  /**
+   * \brief Returns the current state of the generator.
+   */
+  inline void get_state(uint64_t state_out[4]) const {
+    memcpy(state_out, s, sizeof(s));
+  }
+};
+
+//! Four interleaved xoshiro256++ streams.
+/*!
+  The state is stored as structure-of-arrays, one array of four lanes per
+  state word, so that the four streams are advanced together with 256-bit
+  integer instructions when AVX2 is available. The lanes are seeded by
+  jumping a single generator, so their streams do not overlap. The output
+  is the same with and without AVX2.
+
+  \ingroup samplers
+*/
+class Xoshiro256PlusPlusX4 {
+
+  alignas(32) uint64_t s[4][4];
+
+public:
+  explicit Xoshiro256PlusPlusX4(uint64_t seed_in = 0x5DEECE66DULL) {
+    seed(seed_in);
+  }
+
+  /**
+   * \brief Resets the state of the four streams from a 64-bit seed.
+   */
+  void seed(uint64_t seed_in) {
+    Xoshiro256PlusPlus generator(seed_in);
+    for (int lane = 0; lane < 4; lane++) {
+      uint64_t state[4];
+      generator.get_state(state);
+      for (int i = 0; i < 4; i++)
+        s[i][lane] = state[i];
+      generator.jump();
+    }
+  }
+
+  /**
+   * \brief Writes one random number in [0, 1) from each stream.
+   *
+   * The numbers have 52 random bits.
+   */
+  inline void next_doubles(double out[4]) {
+#if defined(__AVX2__)
+    __m256i s0 = _mm256_load_si256((const __m256i *)s[0]);
+    __m256i s1 = _mm256_load_si256((const __m256i *)s[1]);
+    __m256i s2 = _mm256_load_si256((const __m256i *)s[2]);
+    __m256i s3 = _mm256_load_si256((const __m256i *)s[3]);
+
+    __m256i sum = _mm256_add_epi64(s0, s3);
+    __m256i result = _mm256_add_epi64(
+        _mm256_or_si256(_mm256_slli_epi64(sum, 23), _mm256_srli_epi64(sum, 41)),
+        s0);
+    __m256i t = _mm256_slli_epi64(s1, 17);
+
+    s2 = _mm256_xor_si256(s2, s0);
+    s3 = _mm256_xor_si256(s3, s1);
+    s1 = _mm256_xor_si256(s1, s2);
+    s0 = _mm256_xor_si256(s0, s3);
+    s2 = _mm256_xor_si256(s2, t);
+    s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+
+    _mm256_store_si256((__m256i *)s[0], s0);
+    _mm256_store_si256((__m256i *)s[1], s1);
+    _mm256_store_si256((__m256i *)s[2], s2);
+    _mm256_store_si256((__m256i *)s[3], s3);
+
+    // Put the high 52 bits in the mantissa of a double in [1, 2).
+    __m256i bits = _mm256_or_si256(_mm256_srli_epi64(result, 12),
+                                   _mm256_set1_epi64x(0x3FF0000000000000LL));
+    _mm256_storeu_pd(out, _mm256_sub_pd(_mm256_castsi256_pd(bits),
+                                        _mm256_set1_pd(1.0)));
+#else
+    for (int lane = 0; lane < 4; lane++) {
+      uint64_t sum = s[0][lane] + s[3][lane];
+      uint64_t result = ((sum << 23) | (sum >> 41)) + s[0][lane];
+      uint64_t t = s[1][lane] << 17;
+
+      s[2][lane] ^= s[0][lane];
+      s[3][lane] ^= s[1][lane];
+      s[1][lane] ^= s[2][lane];
+      s[0][lane] ^= s[3][lane];
+      s[2][lane] ^= t;
+      s[3][lane] = (s[3][lane] << 45) | (s[3][lane] >> 19);
+
+      uint64_t bits = (result >> 12) | 0x3FF0000000000000ULL;
+      double value;
+      memcpy(&value, &bits, sizeof(value));
+      out[lane] = value - 1.0;
+    }
+#endif
+  }
+};
+} // namespace samplers
+} // namespace smp
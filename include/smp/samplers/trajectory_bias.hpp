@@ -0,0 +1,350 @@
+/*! \file components/samplers/trajectory_bias.h
+  \brief The trajectory bias sampler
+
+  Trajectory biasing technique concentrates samples around the best trajectory
+  in the tree so as to slightly modify it towards an optimal solution.
+
+  * Copyright (C) 2018 Sertac Karaman
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <smp/region.hpp>
+#include <smp/samplers/base.hpp>
+#include <smp/samplers/random.hpp>
+#include <smp/trajectory.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace smp {
+namespace samplers {
+
+//! Implements the sampler component that biases samples around a trajectory.
+/*!
+  A sampler component that implements trajectory biased sampling. This sampler
+  component either outputs a sample that is concentrated around the best
+  trajectory in the tree, or it outputs an unbiased sample. One of the two
+  events is selected randomly.
+
+  A biased sample is drawn uniformly along the length of the trajectory, and
+  then displaced uniformly within a box whose side is the dispersion. Biased
+  samples outside the support are replaced by unbiased ones.
+
+  Dimensions that are angles, such as the heading of a robot, are marked with
+  set_angular_dispersion(). They are interpolated along the shorter way
+  around the circle, displaced by their own dispersion in radians, and
+  wrapped to [-pi, pi].
+
+  The unbiased samples are drawn uniformly from the support or, if the
+  sampler is constructed with another sampler, from that sampler.
+
+  The trajectory is set with update_trajectory(), which has the signature of
+  the update functions of MinimumTimeReachability, so that the samples follow
+  the best trajectory as it improves.
+
+  \ingroup samplers
+*/
+template <class State, class Input, int NUM_DIMENSIONS>
+class TrajectoryBias : public Base<State> {
+
+  using region_t = Region<NUM_DIMENSIONS>;
+  using trajectory_t = Trajectory<State, Input>;
+
+  double bias_probability{0.1};
+
+  double dispersion{1.0};
+
+  // The dispersion of each angular dimension, or a negative number for the
+  // dimensions that are not angles.
+  double angular_dispersion[NUM_DIMENSIONS];
+
+  region_t support;
+  bool has_support;
+
+  // The sampler for the unbiased samples, or NULL to sample the support.
+  Base<State> *sampler;
+
+  // Whether the last sample was drawn by the other sampler, which is then
+  // the one that its report belongs to.
+  bool sampled_by_sampler{false};
+
+  // The states of the trajectory, and the length of the trajectory up to
+  // each of them.
+  std::vector<State> sample_trajectory;
+  std::vector<double> sample_lengths;
+  double length_sample_trajectory{-1.0};
+
+  Xoshiro256PlusPlus generator;
+
+  int sample_biased(State *state_sample_out) {
+
+    // 1. Find the segment of the trajectory that contains a point drawn
+    // uniformly along its length.
+    double sample_length = generator.next_double() * length_sample_trajectory;
+    int index = (int)(std::upper_bound(sample_lengths.begin(),
+                                       sample_lengths.end(), sample_length) -
+                      sample_lengths.begin());
+    if (index >= (int)sample_lengths.size())
+      index = (int)sample_lengths.size() - 1;
+
+    State &state_prev = sample_trajectory[index - 1];
+    State &state_curr = sample_trajectory[index];
+    double length_segment = sample_lengths[index] - sample_lengths[index - 1];
+    double fraction =
+        (length_segment > 0.0)
+            ? (sample_length - sample_lengths[index - 1]) / length_segment
+            : 0.0;
+
+    // 2. Interpolate the point and displace it within the dispersion box.
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      if (angular_dispersion[i] < 0.0) {
+        (*state_sample_out)[i] =
+            (1.0 - fraction) * state_prev[i] + fraction * state_curr[i] +
+            (generator.next_double() - 0.5) * dispersion;
+        continue;
+      }
+      double difference = remainder(state_curr[i] - state_prev[i], 2.0 * M_PI);
+      (*state_sample_out)[i] =
+          remainder(state_prev[i] + fraction * difference +
+                        (generator.next_double() - 0.5) * angular_dispersion[i],
+                    2.0 * M_PI);
+    }
+
+    // 3. Check whether the new state is within the support.
+    if (has_support) {
+      for (int i = 0; i < NUM_DIMENSIONS; i++) {
+        if (fabs((*state_sample_out)[i] - support.center[i]) >=
+            support.size[i] / 2.0)
+          return 0;
+      }
+    }
+
+    return 1;
+  }
+
+public:
+  /**
+   * \brief Constructor for a sampler whose unbiased samples are uniform.
+   */
+  TrajectoryBias() : has_support(true), sampler(NULL) {
+    // Initialize the sampling distribution support.
+    for (int i = 0; i < NUM_DIMENSIONS; i++) {
+      support.center[i] = 0.0;
+      support.size[i] = 1.0;
+      angular_dispersion[i] = -1.0;
+    }
+  }
+
+  /**
+   * \brief Constructor for a sampler whose unbiased samples are drawn from
+   * another sampler.
+   *
+   * Biased samples are only checked against the support if set_support() is
+   * called.
+   *
+   * @param sampler_in The sampler for the unbiased samples.
+   */
+  TrajectoryBias(Base<State> &sampler_in)
+      : has_support(false), sampler(&sampler_in) {
+    for (int i = 0; i < NUM_DIMENSIONS; i++)
+      angular_dispersion[i] = -1.0;
+  }
+
+  ~TrajectoryBias() {}
+
+  int sample(State **state_sample_out) {
+
+    State *state_new = new State;
+    int result = sample_into(state_new);
+    *state_sample_out = state_new;
+
+    return result;
+  }
+
+  int sample_into(State *state_sample_out) {
+
+    sampled_by_sampler = false;
+    if (NUM_DIMENSIONS <= 0)
+      return 0;
+
+    if ((length_sample_trajectory > 0.0) &&
+        (generator.next_double() < bias_probability) &&
+        (sample_biased(state_sample_out) > 0))
+      return 1;
+
+    // If no trajectory biasing, then sample a state without bias.
+    if (sampler) {
+      sampled_by_sampler = true;
+      return sampler->sample_into(state_sample_out);
+    }
+
+    for (int i = 0; i < NUM_DIMENSIONS; i++)
+      (*state_sample_out)[i] = support.size[i] * generator.next_double() -
+                               support.size[i] / 2.0 + support.center[i];
+
+    return 1;
+  }
+
+  int update(State *state_in, double reward) {
+    return sampled_by_sampler ? sampler->update(state_in, reward) : 1;
+  }
+
+  /**
+   * \brief Sets the seed of the pseudo-random number generator.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_seed(uint64_t seed) {
+    generator.seed(seed);
+    return 1;
+  }
+
+  /**
+   * \brief Sets the dimensions and position of the rectangular bounding box of
+   *        the support.
+   *
+   * Biased samples outside the support are discarded. If the sampler draws
+   * its unbiased samples uniformly, they are drawn from the support. If this
+   * function is never called, then the support is initialized to the unit
+   * cube centered at the origin by default.
+   *
+   * @param support_in New support for the sampling distribution.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_support(const region_t support_in) {
+
+    support = support_in;
+    has_support = true;
+
+    return 1;
+  }
+
+  /**
+   * \brief Updates the trajectory around which the samples should be
+   * concentrated.
+   *
+   * The trajectory is copied. This function can be registered with
+   * MinimumTimeReachability::register_new_update_function().
+   *
+   * @param trajectory_in New trajectory for biased sampling.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int update_trajectory(trajectory_t *trajectory_in) {
+
+    sample_trajectory.clear();
+    sample_lengths.clear();
+    length_sample_trajectory = -1.0;
+
+    if (trajectory_in->list_states.size() < 2)
+      return 1;
+
+    double length_curr = 0.0;
+    for (State *state_curr : trajectory_in->list_states) {
+      if (!sample_trajectory.empty()) {
+        State &state_prev = sample_trajectory.back();
+        double length_curr_segment = 0.0;
+        for (int i = 0; i < NUM_DIMENSIONS; i++) {
+          double length_sqrt = (*state_curr)[i] - state_prev[i];
+          if (angular_dispersion[i] >= 0.0)
+            length_sqrt = remainder(length_sqrt, 2.0 * M_PI);
+          length_curr_segment += length_sqrt * length_sqrt;
+        }
+        length_curr += sqrt(length_curr_segment);
+      }
+      sample_trajectory.push_back(*state_curr);
+      sample_lengths.push_back(length_curr);
+    }
+
+    length_sample_trajectory = length_curr;
+
+    return 1;
+  }
+
+  /**
+   * \brief Sample dispersion around the bias trajectory.
+   *
+   * This function sets the side length of the box around the trajectory that
+   * the biased samples are drawn from.
+   *
+   * @param dispersion_in New dispersion for biased sampling.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_sample_dispersion(double dispersion_in) {
+
+    if (dispersion_in > 0.0) {
+      dispersion = dispersion_in;
+      return 1;
+    }
+
+    return 0;
+  }
+
+  /**
+   * \brief Marks a dimension as an angle, and sets its dispersion around the
+   * bias trajectory.
+   *
+   * The angle of a biased sample is interpolated along the shorter way
+   * around the circle, displaced uniformly within the given width in
+   * radians, and wrapped to [-pi, pi]. Should be called before
+   * update_trajectory().
+   *
+   * @param dimension The angular dimension, e.g., the heading of a robot.
+   * @param dispersion_in Width of the displacement in radians.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_angular_dispersion(int dimension, double dispersion_in) {
+
+    if ((dimension < 0) || (dimension >= NUM_DIMENSIONS) ||
+        (dispersion_in < 0.0))
+      return 0;
+
+    angular_dispersion[dimension] = dispersion_in;
+
+    return 1;
+  }
+
+  /**
+   * \brief Sets the probability that the current sample is a trajectory bias.
+   *
+   * Each sample is either an unbiased sample, or a sample biased to be around
+   * the trajectory. Before the sample is drawn, one of these two actions is
+   * selected at random with the probability set using this function.
+   *
+   * @param bias_probability_in Probability that a given sample will be biased
+   *                            around the trajectory
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_bias_probability(double bias_probability_in) {
+
+    if ((bias_probability_in > 0.0) && (bias_probability_in <= 1.0)) {
+      bias_probability = bias_probability_in;
+      return 1;
+    }
+
+    return 0;
+  }
+};
+} // namespace samplers
+} // namespace smp
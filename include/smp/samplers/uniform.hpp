@@ -26,13 +26,19 @@
 
 #include <smp/region.hpp>
 #include <smp/samplers/base.hpp>
+#include <smp/samplers/random.hpp>
+
+#include <cstdint>
 
 namespace smp {
 namespace samplers {
 
 //! Implements the sampler components that relies on uniform sampling.
 /*!
-  A sampler component that implements uniform sampling.
+  A sampler component that implements uniform sampling. Every instance owns
+  a xoshiro256++ generator with an explicit seed, so samplers in different
+  threads do not share any state, and a given seed always gives the same
+  sequence of samples.
 
   \ingroup samplers
 */
@@ -46,6 +52,16 @@ template <class State, int NUM_DIMENSIONS> class Uniform : public Base<State> {
 
   double goal_bias{0.0};
 
+  Xoshiro256PlusPlus generator;
+
+  // Four streams used by sample_batch.
+  Xoshiro256PlusPlusX4 generator_batch;
+
+  // Maps a number in [0, 1) to the given region along the given axis.
+  static inline double scale(const region_t &region, int i, double u) {
+    return region.size[i] * u - region.size[i] / 2.0 + region.center[i];
+  }
+
 public:
   Uniform() {
     // Initialize the sampling distribution support.
@@ -58,8 +74,21 @@ public:
   int set_goal_bias(double bias, const Region<NUM_DIMENSIONS> &region_goal) {
     this->goal_bias = bias;
     this->goal_region = region_goal;
-    time_t t;
-    srand((unsigned)time(&t));
+    return 1;
+  }
+
+  /**
+   * \brief Sets the seed of the pseudo-random number generators.
+   *
+   * @param seed The seed. Equal seeds give equal sequences of samples.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int set_seed(uint64_t seed) {
+    generator.seed(seed);
+    // Use a different seed for the batch streams, so that they do not
+    // repeat the samples of the single stream.
+    generator_batch.seed(~seed);
     return 1;
   }
 
@@ -72,23 +101,65 @@ public:
     }
 
     State *state_new = new State;
+    sample_into(state_new);
+    *state_sample_out = state_new;
+
+    return 1;
+  }
 
-    double randnum1 = double(rand()) / double(RAND_MAX);
+  int sample_into(State *state_sample_out) {
 
-    if (goal_bias > randnum1) {
+    if (NUM_DIMENSIONS <= 0) {
+      return 0;
+    }
+
+    if (goal_bias > generator.next_double()) {
       for (int i = 0; i < NUM_DIMENSIONS; i++)
-        (*state_new)[i] = goal_region.size[i] * rand() / (RAND_MAX + 1.0) -
-                          goal_region.size[i] / 2.0 + goal_region.center[i];
-      *state_sample_out = state_new;
+        (*state_sample_out)[i] =
+            scale(goal_region, i, generator.next_double());
       return 1;
     }
 
     // Generate an independent random variable for each axis.
     for (int i = 0; i < NUM_DIMENSIONS; i++)
-      (*state_new)[i] = support.size[i] * rand() / (RAND_MAX + 1.0) -
-                        support.size[i] / 2.0 + support.center[i];
+      (*state_sample_out)[i] = scale(support, i, generator.next_double());
 
-    *state_sample_out = state_new;
+    return 1;
+  }
+
+  /**
+   * \brief Writes a batch of sample states into an array.
+   *
+   * The samples are drawn four at a time from four interleaved streams,
+   * which are advanced together with SIMD instructions where available.
+   *
+   * @param states_out Array of num_samples states.
+   * @param num_samples Number of samples to draw.
+   *
+   * @returns Returns 1 for success, a non-positive number for failure.
+   */
+  int sample_batch(State *states_out, int num_samples) {
+
+    if (NUM_DIMENSIONS <= 0) {
+      return 0;
+    }
+
+    double bias[4];
+    double values[NUM_DIMENSIONS][4];
+
+    for (int k = 0; k < num_samples; k += 4) {
+      generator_batch.next_doubles(bias);
+      for (int i = 0; i < NUM_DIMENSIONS; i++)
+        generator_batch.next_doubles(values[i]);
+
+      int num_lanes = (num_samples - k < 4) ? num_samples - k : 4;
+      for (int lane = 0; lane < num_lanes; lane++) {
+        const region_t &region =
+            (goal_bias > bias[lane]) ? goal_region : support;
+        for (int i = 0; i < NUM_DIMENSIONS; i++)
+          states_out[k + lane][i] = scale(region, i, values[i][lane]);
+      }
+    }
 
     return 1;
   }
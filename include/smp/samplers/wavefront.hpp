@@ -0,0 +1,143 @@
+/*! \file components/samplers/wavefront.h
+  \brief A distance field over the free cells of a grid map
+
+  This file implements a Dijkstra wavefront over a 2D grid map, which gives
+  the length of the shortest grid path from every free cell to a source
+  region. The field guides the sampling towards the corridors between the
+  start and the goal, and bounds the cost-to-go of a state from below.
+
+  * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+  *
+  * This program is free software: you can redistribute it and/or modify
+  * it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * This program is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with this program.  If not, see <http://www.gnu.org/licenses/>
+  *
+  */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace smp {
+namespace samplers {
+
+//! Distance-to-source field over the free cells of a grid map.
+/*!
+  The field is computed with Dijkstra's algorithm on the 8-connected graph of
+  the free cells, starting from every free cell whose center lies in a source
+  box. Cells that the wavefront does not reach have an infinite distance.
+
+  The grid distance overestimates the length of the shortest continuous path
+  by at most the ratio between the octile and the Euclidean norms, plus the
+  size of the cells around both ends. get_lower_bound() removes both, so it
+  bounds from below the length of every path of the robot center through free
+  cells, as long as the collision checker rejects all states whose cell is
+  not free (which MultipleCirclesCostmap does).
+
+  The collision checker only tests the states along a trajectory, so the
+  trajectory itself can cut through the obstacles between them. The bound
+  still holds if consecutive states are at most one cell apart, i.e., if the
+  step of the extender is at most the resolution of the map. With a larger
+  step, a trajectory can jump over a thin wall that the grid path has to go
+  around, and the bound must not be used.
+
+  \ingroup samplers
+*/
+class Wavefront {
+
+  int size_x;
+  int size_y;
+  double resolution;
+  double origin_x;
+  double origin_y;
+
+  std::vector<double> distances;
+
+  // Binary heap of (distance, cell) pairs, kept to reuse its memory.
+  std::vector<std::pair<double, int>> heap;
+
+public:
+  Wavefront();
+  ~Wavefront();
+
+  /**
+   * \brief Computes the field for a map and a source box.
+   *
+   * @param free_mask Row-major array of size_x_in * size_y_in bytes,
+   *                  non-zero for free cells.
+   * @param size_x_in Number of cells along the x axis.
+   * @param size_y_in Number of cells along the y axis.
+   * @param resolution_in Size of a cell in meters.
+   * @param origin_x_in World x coordinate of the lower-left map corner.
+   * @param origin_y_in World y coordinate of the lower-left map corner.
+   * @param x_min, y_min, x_max, y_max World bounds of the source box. The
+   *        cell that contains the center of the box is a source even if the
+   *        box is smaller than a cell.
+   *
+   * @returns Returns the number of cells reached by the wavefront, or a
+   *          non-positive number if no source cell is free.
+   */
+  int compute(const unsigned char *free_mask, int size_x_in, int size_y_in,
+              double resolution_in, double origin_x_in, double origin_y_in,
+              double x_min, double y_min, double x_max, double y_max);
+
+  /**
+   * \brief Returns the grid distance of a cell, infinity if it is not
+   * reached.
+   */
+  inline double get_distance_cell(int index) const { return distances[index]; }
+
+  /**
+   * \brief Returns the grid distance of the cell that contains a position,
+   * infinity if it is outside the map or not reached.
+   */
+  double get_distance(double x, double y) const;
+
+  /**
+   * \brief Returns a lower bound on the length of a path through free cells
+   * from a position to the source box.
+   *
+   * Only valid for trajectories whose consecutive states are at most one
+   * cell apart.
+   */
+  double get_lower_bound(double x, double y) const;
+
+  /**
+   * \brief Computes sampling weights that favor the cells close to a
+   * shortest path between the sources of two fields.
+   *
+   * The weight of a cell is weight_floor + exp(-excess / width), where the
+   * excess is the length of the shortest grid path between the two sources
+   * through the cell minus the length of the shortest one. Cells that are not
+   * reached by both fields get the floor weight, which keeps every free cell
+   * reachable by the sampler.
+   *
+   * @param field_first, field_second Fields computed on the same map.
+   * @param width Length of the detours that reduce the weight by a factor e.
+   * @param weight_floor Weight of the cells far from the corridor.
+   * @param weights_out Row-major array of the cell weights.
+   *
+   * @returns Returns 1 for success, a non-positive number if the sources
+   *          are not connected on the grid.
+   */
+  static int corridor_weights(const Wavefront &field_first,
+                              const Wavefront &field_second, double width,
+                              double weight_floor,
+                              std::vector<double> &weights_out);
+
+  inline int get_size_x() const { return size_x; }
+  inline int get_size_y() const { return size_y; }
+};
+} // namespace samplers
+} // namespace smp
@@ -18,16 +18,23 @@
  */
 
 // Standard header files
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
 // SMP HEADER FILES ------
-#include <smp/collision_checkers/multiple_circles_mrpt.hpp>
+#include <smp/collision_checkers/cache.hpp>
+#include <smp/collision_checkers/multiple_circles_costmap.hpp>
 #include <smp/distance_evaluators/kdtree.hpp>
 #include <smp/extenders/posq.hpp>
 #include <smp/multipurpose/minimum_time_reachability.hpp>
 #include <smp/planners/rrtstar.hpp>
-#include <smp/samplers/uniform.hpp>
+#include <smp/samplers/adaptive.hpp>
+#include <smp/samplers/bridge.hpp>
+#include <smp/samplers/free_space.hpp>
+#include <smp/samplers/informed.hpp>
+#include <smp/samplers/trajectory_bias.hpp>
+#include <smp/samplers/wavefront.hpp>
 
 #include <smp/trajectory.hpp>
 #include <smp/vertex_edge.hpp>
@@ -54,15 +61,51 @@ class RRTStarPosQGlobalPlanner : public nav_core::BaseGlobalPlanner {
 
 private:
   ros::NodeHandle nh;
-  smp::samplers::Uniform<State, 3> sampler;
+  smp::samplers::FreeSpace<State, 3> sampler;
   smp::extenders::PosQ extender;
-  std::shared_ptr<smp::collision_checkers::MultipleCirclesMRPT<State>>
+  std::shared_ptr<smp::collision_checkers::MultipleCirclesCostmap<State>>
       collision_checker;
+  std::shared_ptr<smp::collision_checkers::Cache<State>> collision_cache;
+
+  // Cells of the costmap where the sampler may place the robot.
+  std::vector<unsigned char> free_mask;
+
+  // Probability of sampling around the best trajectory, and the size of the
+  // box around it that the samples are drawn from, in meters for the
+  // position and in radians for the heading. Disabled if not positive.
+  double trajectory_bias_probability;
+  double trajectory_bias_dispersion;
+  double trajectory_bias_heading_dispersion;
+
+  // Fraction of the samples found by the bridge test, and the standard
+  // deviation of the bridge length. Disabled if not positive.
+  double narrow_passage_ratio;
+  double narrow_passage_deviation;
+
+  // Grid guidance: the length of the detours from the shortest grid path
+  // that reduce the sampling weight of a cell by a factor e, the weight of
+  // the cells far from it, and the distance fields from the start and to the
+  // goal region.
+  bool grid_guidance;
+  double grid_guidance_width;
+  double grid_guidance_floor;
+  smp::samplers::Wavefront wavefront_start;
+  smp::samplers::Wavefront wavefront_goal;
+  std::vector<double> guidance_weights;
+
+  // Adaptive sampling: the side of the bins that the rewards of the samples
+  // are collected in, the smallest acceptance probability of a sample, and
+  // the number of iterations over which a reward is forgotten.
+  bool adaptive_sampling;
+  double adaptive_sampling_bin_size;
+  double adaptive_sampling_floor;
+  double adaptive_sampling_memory;
+
+  int random_seed;
 
   ros::Publisher graph_pub;
 
-  std::shared_ptr<mrpt::maps::COccupancyGridMap2D> map;
-  std::shared_ptr<mrpt::math::CPolygon> footprint;
+  costmap_2d::Costmap2D *costmap;
 
   // Debugging
   geometry_msgs::PoseArray graph;
@@ -75,7 +118,15 @@ protected:
                         std::vector<geometry_msgs::PoseStamped> &plan);
 
 public:
-  inline RRTStarPosQGlobalPlanner() {}
+  inline RRTStarPosQGlobalPlanner()
+      : trajectory_bias_probability(0.0), trajectory_bias_dispersion(0.5),
+        trajectory_bias_heading_dispersion(0.5),
+        narrow_passage_ratio(0.0), narrow_passage_deviation(0.3),
+        grid_guidance(false), grid_guidance_width(2.0),
+        grid_guidance_floor(0.05), adaptive_sampling(false),
+        adaptive_sampling_bin_size(1.0), adaptive_sampling_floor(0.3),
+        adaptive_sampling_memory(10000.0),
+        random_seed(0), costmap(NULL) {}
   inline virtual ~RRTStarPosQGlobalPlanner() {}
 };
 
@@ -23,9 +23,6 @@
 
 std::array<double, 3> distanceBetweenStates(const std::array<double, 3> &state,
                                             const std::array<double, 3> &goal);
-void mrptMapFromROSMsg(
-    const std::shared_ptr<mrpt::maps::COccupancyGridMap2D> &map,
-    const costmap_2d::Costmap2D *rosMap);
 
 namespace smp_ros {
 
@@ -35,41 +32,87 @@ void RRTStarPosQGlobalPlanner::initialize(
   // TODO: All parameters must be configurable.
   graph_pub = nh.advertise<geometry_msgs::PoseArray>("/graph", 100);
 
-  map = std::make_shared<mrpt::maps::COccupancyGridMap2D>();
-  mrptMapFromROSMsg(map, costmap_ros->getCostmap());
+  ros::NodeHandle private_nh("~/" + name);
+
+  int lethal_cost;
+  double inflation_radius;
+  int num_headings;
+  int collision_cache_size;
+  double gain_rho, gain_alpha, gain_beta, velocity_max;
+  private_nh.param("lethal_cost", lethal_cost, 254);
+  private_nh.param("inflation_radius", inflation_radius, 0.15);
+  private_nh.param("num_headings", num_headings, 0);
+  private_nh.param("collision_cache_size", collision_cache_size, 0);
+  private_nh.param("gain_rho", gain_rho, 1.0);
+  private_nh.param("gain_alpha", gain_alpha, 3.0);
+  private_nh.param("gain_beta", gain_beta, -1.0);
+  private_nh.param("velocity_max", velocity_max, 1.0);
+  private_nh.param("random_seed", random_seed, 0);
+  private_nh.param("trajectory_bias_probability", trajectory_bias_probability,
+                   0.0);
+  private_nh.param("trajectory_bias_dispersion", trajectory_bias_dispersion,
+                   0.5);
+  private_nh.param("trajectory_bias_heading_dispersion",
+                   trajectory_bias_heading_dispersion, 0.5);
+  private_nh.param("narrow_passage_ratio", narrow_passage_ratio, 0.0);
+  private_nh.param("narrow_passage_deviation", narrow_passage_deviation, 0.3);
+  private_nh.param("grid_guidance", grid_guidance, false);
+  private_nh.param("grid_guidance_width", grid_guidance_width, 2.0);
+  private_nh.param("grid_guidance_floor", grid_guidance_floor, 0.05);
+  private_nh.param("adaptive_sampling", adaptive_sampling, false);
+  private_nh.param("adaptive_sampling_bin_size", adaptive_sampling_bin_size,
+                   1.0);
+  private_nh.param("adaptive_sampling_floor", adaptive_sampling_floor, 0.3);
+  private_nh.param("adaptive_sampling_memory", adaptive_sampling_memory,
+                   10000.0);
+
+  costmap = costmap_ros->getCostmap();
 
   std::vector<geometry_msgs::Point> footprint_pt =
       costmap_ros->getRobotFootprint();
-  footprint = std::make_shared<mrpt::math::CPolygon>();
+  std::vector<std::array<double, 2>> footprint;
 
   for (const auto &point : footprint_pt) {
-    footprint->AddVertex(point.x, point.y);
+    footprint.push_back({{point.x, point.y}});
   }
 
   if (footprint_pt.size() != 4) {
     ROS_WARN("Footprint wasn't a polygon. Setting to default values.");
-    footprint->AddVertex(0.25, 0.125);
-    footprint->AddVertex(0.25, -0.125);
-    footprint->AddVertex(-0.25, 0.125);
-    footprint->AddVertex(-0.25, -0.125);
+    footprint.clear();
+    footprint.push_back({{0.25, 0.125}});
+    footprint.push_back({{0.25, -0.125}});
+    footprint.push_back({{-0.25, 0.125}});
+    footprint.push_back({{-0.25, -0.125}});
   } else {
     ROS_INFO("RRTStarPosQGlobalPlanner got a polygon footprint.");
   }
 
-  // TODO: Inflation radius and footprint must be configurable.
-  collision_checker =
-      std::make_shared<smp::collision_checkers::MultipleCirclesMRPT<State>>(
-          map, 0.15, footprint);
+  // The collision checker reads the costmap in place. Its clearance field is
+  // synchronized with the costmap at the beginning of every makePlan call.
+  collision_checker = std::make_shared<
+      smp::collision_checkers::MultipleCirclesCostmap<State>>();
+  collision_checker->set_robot_footprint(footprint);
+  collision_checker->set_inflation_radius(inflation_radius);
+  collision_checker->set_lethal_cost((unsigned char)lethal_cost);
+  collision_checker->set_num_headings(num_headings);
+
+  if (collision_cache_size > 0) {
+    collision_cache = std::make_shared<smp::collision_checkers::Cache<State>>(
+        *collision_checker, collision_cache_size);
+  }
+
+  if (extender.set_gains(gain_rho, gain_alpha, gain_beta) <= 0)
+    ROS_WARN("Invalid PosQ gains. Using the default gains.");
+  if (extender.set_velocity_max(velocity_max) <= 0)
+    ROS_WARN("Invalid velocity_max. Using the default velocity.");
 
-  // Sampler support should also be configurable.
+  // The positions are sampled from the free cells of the costmap, so only
+  // the heading uses the support.
   smp::Region<3> sampler_support;
-  sampler_support.center[0] = 0.0;
-  sampler_support.size[0] = 10.0;
-  sampler_support.center[1] = 0.0;
-  sampler_support.size[1] = 10.0;
   sampler_support.center[2] = 0.0;
-  sampler_support.size[2] = 2 * 3.14;
+  sampler_support.size[2] = 2 * M_PI;
   sampler.set_support(sampler_support);
+  sampler.set_seed(random_seed);
 }
 
 bool RRTStarPosQGlobalPlanner::makePlan(
@@ -81,12 +124,109 @@ bool RRTStarPosQGlobalPlanner::makePlan(
   smp::multipurpose::MinimumTimeReachability<State, Input, 3>
       min_time_reachability;
 
+  // The collision checker, and the background thread of the bridge sampler,
+  // read the costmap in place. Keep it locked until both are done with it.
+  boost::unique_lock<costmap_2d::Costmap2D::mutex_t> lock(
+      *(costmap->getMutex()));
+  collision_checker->set_map(
+      costmap->getCharMap(), costmap->getSizeInCellsX(),
+      costmap->getSizeInCellsY(), costmap->getResolution(),
+      costmap->getOriginX(), costmap->getOriginY());
+  collision_checker->sync();
+
+  // Find the free cells of the costmap for the sampler.
+  if (collision_checker->get_free_cells(free_mask) <= 0) {
+    ROS_ERROR("The costmap has no free cells. Planning failed.");
+    return false;
+  }
+
+  smp::collision_checkers::Base<State> *planner_collision_checker =
+      collision_checker.get();
+  if (collision_cache) {
+    // Bin the headings like the heading bitmaps, and drop the cached results
+    // around the cells that changed since the previous plan.
+    double x_min, y_min, x_max, y_max;
+    collision_cache->set_discretization(
+        costmap->getResolution(), costmap->getOriginX(), costmap->getOriginY(),
+        collision_checker->get_num_headings());
+    collision_cache->set_reach(collision_checker->get_reach());
+    if (collision_checker->get_sync_window(&x_min, &y_min, &x_max, &y_max))
+      collision_cache->invalidate(x_min, y_min, x_max, y_max);
+    collision_cache->reset_statistics();
+    planner_collision_checker = collision_cache.get();
+  }
+
+  // With adaptive sampling, fewer samples are drawn in the regions where
+  // they keep failing to extend the tree.
+  smp::samplers::Adaptive<State, 3> adaptive_sampler(sampler);
+  smp::samplers::Base<State> *free_space_sampler = &sampler;
+  if (adaptive_sampling) {
+    smp::Region<3> adaptive_support;
+    adaptive_support.center[0] =
+        costmap->getOriginX() + costmap->getSizeInMetersX() / 2.0;
+    adaptive_support.size[0] = costmap->getSizeInMetersX();
+    adaptive_support.center[1] =
+        costmap->getOriginY() + costmap->getSizeInMetersY() / 2.0;
+    adaptive_support.size[1] = costmap->getSizeInMetersY();
+    adaptive_sampler.set_support(adaptive_support, adaptive_sampling_bin_size);
+    adaptive_sampler.set_weight_floor(adaptive_sampling_floor);
+    adaptive_sampler.set_memory(adaptive_sampling_memory);
+    adaptive_sampler.set_seed(random_seed);
+    free_space_sampler = &adaptive_sampler;
+  }
+
+  // Part of the samples are found in narrow passages by the bridge test,
+  // which runs against the costmap in a background thread while planning.
+  smp::samplers::Bridge<State, 3> bridge_sampler(*collision_checker,
+                                                 *free_space_sampler);
+  if (narrow_passage_ratio > 0.0) {
+    smp::Region<3> bridge_support;
+    bridge_support.center[0] =
+        costmap->getOriginX() + costmap->getSizeInMetersX() / 2.0;
+    bridge_support.size[0] = costmap->getSizeInMetersX();
+    bridge_support.center[1] =
+        costmap->getOriginY() + costmap->getSizeInMetersY() / 2.0;
+    bridge_support.size[1] = costmap->getSizeInMetersY();
+    bridge_support.size[2] = 2 * M_PI;
+    bridge_sampler.set_support(bridge_support);
+    bridge_sampler.set_seed(random_seed);
+    bridge_sampler.set_deviation(0, narrow_passage_deviation);
+    bridge_sampler.set_deviation(1, narrow_passage_deviation);
+    bridge_sampler.set_deviation(2, 0.0);
+  }
+  bridge_sampler.set_mix_ratio(
+      std::min(std::max(narrow_passage_ratio, 0.0), 1.0));
+
+  // Once a solution is found, part of the samples are drawn around it.
+  smp::samplers::TrajectoryBias<State, Input, 3> trajectory_bias_sampler(
+      bridge_sampler);
+  trajectory_bias_sampler.set_seed(random_seed);
+  if (trajectory_bias_probability > 0.0) {
+    trajectory_bias_sampler.set_bias_probability(trajectory_bias_probability);
+    trajectory_bias_sampler.set_sample_dispersion(trajectory_bias_dispersion);
+    trajectory_bias_sampler.set_angular_dispersion(
+        2, trajectory_bias_heading_dispersion);
+    min_time_reachability.register_new_update_function(
+        [&trajectory_bias_sampler](Trajectory *trajectory) {
+          return trajectory_bias_sampler.update_trajectory(trajectory);
+        });
+  }
+
+  // Only states that can improve the solution are sampled.
+  smp::samplers::Informed<State, Input, 3> informed_sampler(
+      trajectory_bias_sampler, extender);
+  informed_sampler.set_best_cost_function([&min_time_reachability]() {
+    return min_time_reachability.get_best_cost();
+  });
+
   smp::planners::RRTStar<State, Input> planner(
-      sampler, distance_evaluator, extender, *collision_checker,
-      min_time_reachability, min_time_reachability);
+      informed_sampler, distance_evaluator, extender,
+      *planner_collision_checker, min_time_reachability, min_time_reachability);
 
   planner.parameters.set_phase(2);
-  planner.parameters.set_gamma(std::max(map->getXMax(), map->getYMax()));
+  planner.parameters.set_gamma(
+      std::max(costmap->getOriginX() + costmap->getSizeInMetersX(),
+               costmap->getOriginY() + costmap->getSizeInMetersY()));
   planner.parameters.set_dimension(3);
   planner.parameters.set_max_radius(10.0);
 
@@ -114,8 +254,74 @@ bool RRTStarPosQGlobalPlanner::makePlan(
   region_goal.size[2] = 0.2;
 
   min_time_reachability.set_goal_region(region_goal);
+  informed_sampler.set_goal_region(region_goal);
   min_time_reachability.set_distance_function(distanceBetweenStates);
 
+  // With grid guidance, the free cells along the shortest grid paths from
+  // the start to the goal region are sampled more often, and the grid
+  // distance to the goal region bounds the cost-to-go of the samples.
+  const double *cell_weights = NULL;
+  if (grid_guidance) {
+    ros::WallTime guidance_start = ros::WallTime::now();
+    // MinimumTimeReachability accepts the states within the size of the goal
+    // region from its center.
+    wavefront_goal.compute(
+        free_mask.data(), costmap->getSizeInCellsX(),
+        costmap->getSizeInCellsY(), costmap->getResolution(),
+        costmap->getOriginX(), costmap->getOriginY(),
+        region_goal.center[0] - region_goal.size[0],
+        region_goal.center[1] - region_goal.size[1],
+        region_goal.center[0] + region_goal.size[0],
+        region_goal.center[1] + region_goal.size[1]);
+    wavefront_start.compute(
+        free_mask.data(), costmap->getSizeInCellsX(),
+        costmap->getSizeInCellsY(), costmap->getResolution(),
+        costmap->getOriginX(), costmap->getOriginY(), start.pose.position.x,
+        start.pose.position.y, start.pose.position.x, start.pose.position.y);
+
+    if (smp::samplers::Wavefront::corridor_weights(
+            wavefront_start, wavefront_goal, grid_guidance_width,
+            grid_guidance_floor, guidance_weights) > 0) {
+      cell_weights = guidance_weights.data();
+
+      // The grid distance only bounds the trajectories whose consecutive
+      // states are at most one cell apart.
+      if (extender.get_step_max() > costmap->getResolution()) {
+        ROS_WARN("The extender steps farther than one costmap cell. The "
+                 "grid distance does not bound the cost-to-go.");
+      } else {
+        // The bound of the extender over one meter converts lengths to
+        // costs.
+        State state_origin, state_unit;
+        for (int i = 0; i < 3; i++) {
+          state_origin[i] = 0.0;
+          state_unit[i] = 0.0;
+        }
+        state_unit[0] = 1.0;
+        double cost_per_meter =
+            extender.cost_lower_bound(&state_origin, &state_unit);
+        informed_sampler.set_cost_to_go_function(
+            [this, cost_per_meter](State *state) {
+              return cost_per_meter *
+                     wavefront_goal.get_lower_bound((*state)[0], (*state)[1]);
+            });
+      }
+    } else {
+      ROS_WARN("The start and the goal are not connected on the costmap. "
+               "Sampling without grid guidance.");
+    }
+    ROS_INFO("Grid guidance took %lf sec.",
+             (ros::WallTime::now() - guidance_start).toSec());
+  }
+
+  if (sampler.set_map(free_mask.data(), costmap->getSizeInCellsX(),
+                      costmap->getSizeInCellsY(), costmap->getResolution(),
+                      costmap->getOriginX(), costmap->getOriginY(),
+                      cell_weights) <= 0) {
+    ROS_ERROR("The sampler has no cells to draw from. Planning failed.");
+    return false;
+  }
+
   sampler.set_goal_bias(0.05, region_goal);
 
   State *state_initial = new State;
@@ -131,8 +337,12 @@ bool RRTStarPosQGlobalPlanner::makePlan(
   } else
     ROS_INFO("Start state is not in collision.");
 
+  informed_sampler.set_root(state_initial);
   planner.initialize(state_initial);
 
+  if (narrow_passage_ratio > 0.0)
+    bridge_sampler.start();
+
   ros::Time t = ros::Time::now();
   // 3. RUN THE PLANNER
   int i = 0;
@@ -157,6 +367,31 @@ bool RRTStarPosQGlobalPlanner::makePlan(
     ROS_INFO_THROTTLE(1.0, "Planner iteration : %d", i);
   }
 
+  bridge_sampler.stop();
+  lock.unlock();
+  if (narrow_passage_ratio > 0.0) {
+    ROS_INFO("Bridge sampler used %lu candidates (%lu buffer misses).",
+             bridge_sampler.get_num_candidates(),
+             bridge_sampler.get_num_buffer_misses());
+  }
+
+  if (adaptive_sampling) {
+    ROS_INFO("Adaptive sampler rejected %lu of %lu samples.",
+             adaptive_sampler.get_num_rejections(),
+             adaptive_sampler.get_num_samples());
+  }
+
+  if (collision_cache) {
+    ROS_INFO("Collision cache hit rate: %lf (%zu of %zu slots used).",
+             collision_cache->get_hit_rate(),
+             collision_cache->get_num_entries(),
+             collision_cache->get_capacity());
+  }
+
+  ROS_INFO("Informed sampler rejected %lu of %lu samples.",
+           informed_sampler.get_num_rejections(),
+           informed_sampler.get_num_samples());
+
   Trajectory trajectory_final;
   min_time_reachability.get_solution(trajectory_final);
 
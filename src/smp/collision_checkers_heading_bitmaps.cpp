@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <smp/collision_checkers/heading_bitmaps.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+namespace smp {
+namespace collision_checkers {
+
+HeadingBitmaps::HeadingBitmaps()
+    : num_headings(0), size_x(0), size_y(0), words_per_row(0), extent(0) {}
+
+HeadingBitmaps::~HeadingBitmaps() {}
+
+int HeadingBitmaps::set_footprint(
+    const std::vector<std::array<double, 2>> &footprint,
+    double inflation_radius, double resolution, int num_headings_in) {
+
+  if ((num_headings_in <= 0) || (resolution <= 0.0)) {
+    std::cerr << "[set_footprint]: INVALID ARGUMENTS!\n";
+    return 0;
+  }
+
+  num_headings = num_headings_in;
+
+  std::vector<std::array<double, 2>> vertices(1, {{0.0, 0.0}});
+  vertices.insert(vertices.end(), footprint.begin(), footprint.end());
+
+  // Growth of the circles that accounts for the position of the robot and of
+  // the obstacle within their cells.
+  const double cell_margin = resolution * sqrt(2.0);
+  const double half_slice = M_PI / num_headings;
+
+  extent = 0;
+  for (const auto &vertex : vertices) {
+    double norm = sqrt(vertex[0] * vertex[0] + vertex[1] * vertex[1]);
+    double reach = norm + inflation_radius + cell_margin + norm * half_slice;
+    extent = std::max(extent, (int)ceil(reach / resolution));
+  }
+
+  masks.assign(num_headings, std::vector<MaskRun>());
+  std::vector<unsigned char> row(2 * extent + 1);
+
+  for (int m = 0; m < num_headings; m++) {
+    double theta = 2.0 * M_PI * m / num_headings;
+    double cos_theta = cos(theta);
+    double sin_theta = sin(theta);
+
+    for (int dy = -extent; dy <= extent; dy++) {
+      std::fill(row.begin(), row.end(), 0);
+
+      for (const auto &vertex : vertices) {
+        double center_x = vertex[0] * cos_theta - vertex[1] * sin_theta;
+        double center_y = vertex[0] * sin_theta + vertex[1] * cos_theta;
+        double norm = sqrt(vertex[0] * vertex[0] + vertex[1] * vertex[1]);
+        double radius = inflation_radius + cell_margin + norm * half_slice;
+
+        double offset_y = dy * resolution - center_y;
+        for (int dx = -extent; dx <= extent; dx++) {
+          double offset_x = dx * resolution - center_x;
+          if (offset_x * offset_x + offset_y * offset_y < radius * radius)
+            row[dx + extent] = 1;
+        }
+      }
+
+      for (int dx = -extent; dx <= extent; dx++) {
+        if (!row[dx + extent])
+          continue;
+        if ((dx > -extent) && row[dx + extent - 1])
+          masks[m].back().dx_max = dx;
+        else
+          masks[m].push_back({dy, dx, dx});
+      }
+    }
+  }
+
+  resize(size_x, size_y);
+
+  return 1;
+}
+
+void HeadingBitmaps::resize(int size_x_in, int size_y_in) {
+
+  size_x = size_x_in;
+  size_y = size_y_in;
+  words_per_row = (size_x + 63) / 64;
+  slices.assign(num_headings,
+                std::vector<uint64_t>(words_per_row * size_y, 0));
+}
+
+int HeadingBitmaps::update(const unsigned char *obstacles, int x_min,
+                           int y_min, int x_max, int y_max) {
+
+  if (num_headings == 0) {
+    std::cerr << "[update]: NO FOOTPRINT!\n";
+    return 0;
+  }
+
+  x_min = std::max(x_min, 0);
+  y_min = std::max(y_min, 0);
+  x_max = std::min(x_max, size_x);
+  y_max = std::min(y_max, size_y);
+  if ((x_min >= x_max) || (y_min >= y_max))
+    return 1;
+
+  // Count the obstacle cells in each row of the window grown by the extent
+  // of the masks, so that any run of a mask is tested in constant time.
+  int wx_min = std::max(x_min - extent, 0);
+  int wy_min = std::max(y_min - extent, 0);
+  int wx_max = std::min(x_max + extent, size_x);
+  int wy_max = std::min(y_max + extent, size_y);
+  int stride = wx_max - wx_min + 1;
+
+  prefix_counts.resize(stride * (wy_max - wy_min));
+  for (int y = wy_min; y < wy_max; y++) {
+    int *counts = &prefix_counts[(y - wy_min) * stride];
+    const unsigned char *obstacles_row = &obstacles[y * size_x];
+    counts[0] = 0;
+    for (int x = wx_min; x < wx_max; x++)
+      counts[x - wx_min + 1] = counts[x - wx_min] + (obstacles_row[x] != 0);
+  }
+
+  for (int m = 0; m < num_headings; m++) {
+    const std::vector<MaskRun> &mask = masks[m];
+    uint64_t *slice = slices[m].data();
+
+    for (int y = y_min; y < y_max; y++) {
+      uint64_t *slice_row = &slice[y * words_per_row];
+
+      for (int x = x_min; x < x_max; x++) {
+        bool occupied = false;
+        for (const auto &run : mask) {
+          int yy = y + run.dy;
+          int xx_min = x + run.dx_min;
+          int xx_max = x + run.dx_max;
+
+          // Cells outside the map are obstacles.
+          if ((yy < 0) || (yy >= size_y) || (xx_min < 0) ||
+              (xx_max >= size_x)) {
+            occupied = true;
+            break;
+          }
+
+          const int *counts = &prefix_counts[(yy - wy_min) * stride];
+          if (counts[xx_max - wx_min + 1] != counts[xx_min - wx_min]) {
+            occupied = true;
+            break;
+          }
+        }
+
+        const uint64_t bit = (uint64_t)1 << (x & 63);
+        if (occupied)
+          slice_row[x >> 6] |= bit;
+        else
+          slice_row[x >> 6] &= ~bit;
+      }
+    }
+  }
+
+  return 1;
+}
+} // namespace collision_checkers
+} // namespace smp
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <smp/collision_checkers/occupancy_pyramid.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace smp {
+namespace collision_checkers {
+
+OccupancyPyramid::OccupancyPyramid()
+    : size_x(0), size_y(0), resolution(0.05), origin_x(0.0), origin_y(0.0) {}
+
+OccupancyPyramid::~OccupancyPyramid() {}
+
+void OccupancyPyramid::resize(int size_x_in, int size_y_in,
+                              double resolution_in, double origin_x_in,
+                              double origin_y_in) {
+
+  size_x = size_x_in;
+  size_y = size_y_in;
+  resolution = resolution_in;
+  origin_x = origin_x_in;
+  origin_y = origin_y_in;
+
+  level_size_x.clear();
+  level_size_y.clear();
+  levels.clear();
+
+  int level_x = size_x;
+  int level_y = size_y;
+  while (true) {
+    level_size_x.push_back(level_x);
+    level_size_y.push_back(level_y);
+    levels.push_back(std::vector<unsigned char>(level_x * level_y, 0));
+    if ((level_x <= 1) && (level_y <= 1))
+      break;
+    level_x = (level_x + 1) / 2;
+    level_y = (level_y + 1) / 2;
+  }
+}
+
+void OccupancyPyramid::set_origin(double origin_x_in, double origin_y_in) {
+  origin_x = origin_x_in;
+  origin_y = origin_y_in;
+}
+
+void OccupancyPyramid::pool(int level, int x_min, int y_min, int x_max,
+                            int y_max) {
+
+  const std::vector<unsigned char> &fine = levels[level - 1];
+  std::vector<unsigned char> &coarse = levels[level];
+  int fine_x = level_size_x[level - 1];
+  int fine_y = level_size_y[level - 1];
+  int coarse_x = level_size_x[level];
+
+  for (int y = y_min / 2; y <= y_max / 2; y++) {
+    for (int x = x_min / 2; x <= x_max / 2; x++) {
+      unsigned char value = 0;
+      for (int fy = 2 * y; fy < std::min(2 * y + 2, fine_y); fy++)
+        for (int fx = 2 * x; fx < std::min(2 * x + 2, fine_x); fx++)
+          value |= fine[fy * fine_x + fx];
+      coarse[y * coarse_x + x] = value;
+    }
+  }
+}
+
+void OccupancyPyramid::set_cell(int x, int y, bool occupied) {
+
+  if ((x < 0) || (y < 0) || (x >= size_x) || (y >= size_y))
+    return;
+
+  unsigned char value = occupied ? 1 : 0;
+  if (levels[0][y * size_x + x] == value)
+    return;
+  levels[0][y * size_x + x] = value;
+
+  for (int level = 1; level < (int)levels.size(); level++) {
+    pool(level, x, y, x, y);
+    x /= 2;
+    y /= 2;
+  }
+}
+
+int OccupancyPyramid::update(const unsigned char *occupied, int x_min,
+                             int y_min, int x_max, int y_max) {
+
+  if (levels.empty()) {
+    std::cerr << "[update]: NO MAP!\n";
+    return 0;
+  }
+
+  x_min = std::max(x_min, 0);
+  y_min = std::max(y_min, 0);
+  x_max = std::min(x_max, size_x);
+  y_max = std::min(y_max, size_y);
+  if ((x_min >= x_max) || (y_min >= y_max))
+    return 1;
+
+  for (int y = y_min; y < y_max; y++)
+    for (int x = x_min; x < x_max; x++)
+      levels[0][y * size_x + x] = (occupied[y * size_x + x] != 0);
+
+  // Inclusive bounds of the changed cells at the current level.
+  x_max--;
+  y_max--;
+  for (int level = 1; level < (int)levels.size(); level++) {
+    pool(level, x_min, y_min, x_max, y_max);
+    x_min /= 2;
+    y_min /= 2;
+    x_max /= 2;
+    y_max /= 2;
+  }
+
+  return 1;
+}
+
+bool OccupancyPyramid::is_free_at(int level, int x_min, int y_min, int x_max,
+                                  int y_max) const {
+
+  const std::vector<unsigned char> &cells = levels[level];
+  int cells_x = level_size_x[level];
+
+  for (int y = y_min >> level; y <= y_max >> level; y++) {
+    for (int x = x_min >> level; x <= x_max >> level; x++) {
+      if (!cells[y * cells_x + x])
+        continue;
+      if (level == 0)
+        return false;
+
+      // Descend into the part of the occupied coarse cell that intersects
+      // the rectangle.
+      int child_x_min = std::max(x_min, x << level);
+      int child_y_min = std::max(y_min, y << level);
+      int child_x_max = std::min(x_max, ((x + 1) << level) - 1);
+      int child_y_max = std::min(y_max, ((y + 1) << level) - 1);
+      if (!is_free_at(level - 1, child_x_min, child_y_min, child_x_max,
+                      child_y_max))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+int OccupancyPyramid::is_free(int x_min, int y_min, int x_max,
+                              int y_max) const {
+
+  if ((x_min < 0) || (y_min < 0) || (x_max >= size_x) || (y_max >= size_y))
+    return 0;
+  if ((x_min > x_max) || (y_min > y_max))
+    return 1;
+
+  // Start at the finest level at which the rectangle spans at most 2x2
+  // cells.
+  int level = 0;
+  while ((level + 1 < (int)levels.size()) &&
+         (((x_max >> level) - (x_min >> level) > 1) ||
+          ((y_max >> level) - (y_min >> level) > 1)))
+    level++;
+
+  return is_free_at(level, x_min, y_min, x_max, y_max) ? 1 : 0;
+}
+
+int OccupancyPyramid::is_free(double x_min, double y_min, double x_max,
+                              double y_max) const {
+
+  return is_free((int)floor((x_min - origin_x) / resolution),
+                 (int)floor((y_min - origin_y) / resolution),
+                 (int)floor((x_max - origin_x) / resolution),
+                 (int)floor((y_max - origin_y) / resolution));
+}
+} // namespace collision_checkers
+} // namespace smp
@@ -18,7 +18,6 @@
  */
 
 #define DISTANCE_LIMIT 100.0
-#define DELTA_DISTANCE 0.25
 
 #ifndef DBL_MAX
 #define DBL_MAX 10000000000000000.0
@@ -26,345 +25,413 @@
 
 #include <smp/extenders/dubins.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 
 namespace smp {
 namespace extenders {
 
-int Dubins::extend_dubins_spheres(
-    double x_s1, double y_s1, double t_s1, double x_s2, double y_s2,
-    double t_s2, int comb_no, int *fully_extends,
-    std::list<StateDubins *> *list_states,
-    std::list<InputDubins *> *list_inputs) {
+// Turn directions of the three segments of every path word, 1 for a left
+// turn, -1 for a right turn and 0 for a straight segment.
+static const int dubins_words[6][3] = {{1, 0, 1},  {-1, 0, -1}, {1, 0, -1},
+                                       {-1, 0, 1}, {-1, 1, -1}, {1, -1, 1}};
 
-  double x_tr = x_s2 - x_s1;
-  double y_tr = y_s2 - y_s1;
-  double t_tr = atan2(y_tr, x_tr);
-
-  double distance = sqrt(x_tr * x_tr + y_tr * y_tr);
+static inline double mod_2pi(double angle) {
+  return angle - 2.0 * M_PI * floor(angle / (2.0 * M_PI));
+}
 
-  double x_start;
-  double y_start;
-  double t_start;
-  double x_end;
-  double y_end;
-  double t_end;
+// Computes a lower bound on the length of the shortest word in the
+// normalized frame, where the initial position is the origin, the final
+// position is at the distance d on the x axis and the turning radius is one.
+// The bound takes no trigonometric function.
+static inline double dubins_bound(double d, double sa, double ca, double sb,
+                                  double cb) {
+
+  double cab = ca * cb + sa * sb;
+  double d_sq = d * d;
+
+  // The straight segment of every CSC word, and the middle arc of every CCC
+  // word, are shorter than the word.
+  double p_sq_min = 2.0 + d_sq - 2.0 * cab - 2.0 * d * fabs(sa - sb);
+  double p_sq_lsr = -2.0 + d_sq + 2.0 * cab + 2.0 * d * (sa + sb);
+  double p_sq_rsl = -2.0 + d_sq + 2.0 * cab - 2.0 * d * (sa + sb);
+  if (p_sq_lsr >= 0.0)
+    p_sq_min = std::min(p_sq_min, p_sq_lsr);
+  if (p_sq_rsl >= 0.0)
+    p_sq_min = std::min(p_sq_min, p_sq_rsl);
+
+  double bound = sqrt(std::max(p_sq_min, 0.0));
+  if (d < 4.0)
+    bound = std::min(bound, M_PI);
+
+  // Every path is longer than the distance between its ends.
+  return std::max(bound, d);
+}
 
-  if (distance > 2 * turning_radius) { // disks do not intersect
+// Solves for the shortest word in the normalized frame. Words that are not
+// shorter than length_max are skipped. Returns the index of the word, or -1
+// if there is none.
+static int dubins_shortest(double d, double alpha, double beta, double sa,
+                           double ca, double sb, double cb, double length_max,
+                           double *lengths_out) {
+
+  // The states coincide. Every word would loop around a full circle.
+  if ((d == 0.0) && (sa == sb) && (ca == cb)) {
+    for (int j = 0; j < 3; j++)
+      lengths_out[j] = 0.0;
+    return 0;
+  }
 
-    double t_balls = acos(2 * turning_radius / distance);
+  double cab = ca * cb + sa * sb;
+  double d_sq = d * d;
+
+  // 1. Compute the length of the straight segment of every CSC word, which
+  // takes no trigonometric function and bounds the length of the word.
+  double p_sq[4];
+  p_sq[0] = 2.0 + d_sq - 2.0 * cab + 2.0 * d * (sa - sb);
+  p_sq[1] = 2.0 + d_sq - 2.0 * cab + 2.0 * d * (sb - sa);
+  p_sq[2] = -2.0 + d_sq + 2.0 * cab + 2.0 * d * (sa + sb);
+  p_sq[3] = -2.0 + d_sq + 2.0 * cab - 2.0 * d * (sa + sb);
+
+  int order[4] = {0, 1, 2, 3};
+  for (int i = 1; i < 4; i++)
+    for (int j = i; (j > 0) && (p_sq[order[j]] < p_sq[order[j - 1]]); j--)
+      std::swap(order[j], order[j - 1]);
+
+  // 2. Compute the arcs of the words in the order of their bounds, and skip
+  // the words whose bound is longer than the shortest word so far.
+  int word_min = -1;
+  double length_min = length_max;
+  double lengths[3];
+  double tmp;
+
+  for (int k = 0; k < 4; k++) {
+    int word = order[k];
+    if (p_sq[word] < 0.0)
+      continue;
+
+    lengths[1] = sqrt(p_sq[word]);
+    if (lengths[1] >= length_min)
+      break;
 
-    switch (comb_no) {
-    case 1:
-      t_start = t_tr - t_balls;
-      t_end = t_tr + M_PI - t_balls;
+    switch (word) {
+    case 0: // LSL
+      tmp = atan2(cb - ca, d + sa - sb);
+      lengths[0] = mod_2pi(tmp - alpha);
+      lengths[2] = mod_2pi(beta - tmp);
       break;
-    case 2:
-      t_start = t_tr + t_balls;
-      t_end = t_tr - M_PI + t_balls;
+    case 1: // RSR
+      tmp = atan2(ca - cb, d - sa + sb);
+      lengths[0] = mod_2pi(alpha - tmp);
+      lengths[2] = mod_2pi(tmp - beta);
       break;
-    case 3:
-      t_start = t_tr - M_PI_2;
-      t_end = t_tr - M_PI_2;
+    case 2: // LSR
+      tmp = atan2(-ca - cb, d + sa + sb) - atan2(-2.0, lengths[1]);
+      lengths[0] = mod_2pi(tmp - alpha);
+      lengths[2] = mod_2pi(tmp - beta);
       break;
-    case 4:
-      t_start = t_tr + M_PI_2;
-      t_end = t_tr + M_PI_2;
+    default: // RSL
+      tmp = atan2(ca + cb, d - sa - sb) - atan2(2.0, lengths[1]);
+      lengths[0] = mod_2pi(alpha - tmp);
+      lengths[2] = mod_2pi(beta - tmp);
       break;
-    default:
-      return -1.0;
     }
-  }
 
-  else { // disks are intersecting
+    double length = lengths[0] + lengths[1] + lengths[2];
+    if (length < length_min) {
+      word_min = word;
+      length_min = length;
+      for (int j = 0; j < 3; j++)
+        lengths_out[j] = lengths[j];
+    }
+  }
 
-    switch (comb_no) {
-    case 1:
-    case 2:
-      // No solution
-      if (list_states) {
-        list_states->clear();
-        list_inputs->clear();
+  // 3. Compute the CCC words, whose middle arc is longer than a half turn,
+  // only if they may be shorter. They exist only if the positions are
+  // closer than four turning radii.
+  if ((d < 4.0) && (M_PI < length_min)) {
+
+    // RLR
+    tmp = (6.0 - d_sq + 2.0 * cab + 2.0 * d * (sa - sb)) / 8.0;
+    if (fabs(tmp) <= 1.0) {
+      lengths[1] = mod_2pi(2.0 * M_PI - acos(tmp));
+      lengths[0] =
+          mod_2pi(alpha - atan2(ca - cb, d - sa + sb) + lengths[1] / 2.0);
+      lengths[2] = mod_2pi(alpha - beta - lengths[0] + lengths[1]);
+
+      double length = lengths[0] + lengths[1] + lengths[2];
+      if (length < length_min) {
+        word_min = 4;
+        length_min = length;
+        for (int j = 0; j < 3; j++)
+          lengths_out[j] = lengths[j];
       }
-      return -1.0;
-      break;
+    }
 
-    case 3:
-      t_start = t_tr - M_PI_2;
-      t_end = t_tr - M_PI_2;
-      break;
-    case 4:
-      t_start = t_tr + M_PI_2;
-      t_end = t_tr + M_PI_2;
-      break;
+    // LRL
+    tmp = (6.0 - d_sq + 2.0 * cab + 2.0 * d * (sb - sa)) / 8.0;
+    if (fabs(tmp) <= 1.0) {
+      lengths[1] = mod_2pi(2.0 * M_PI - acos(tmp));
+      lengths[0] =
+          mod_2pi(-alpha - atan2(ca - cb, d + sa - sb) + lengths[1] / 2.0);
+      lengths[2] = mod_2pi(beta - alpha - lengths[0] + lengths[1]);
+
+      double length = lengths[0] + lengths[1] + lengths[2];
+      if (length < length_min) {
+        word_min = 5;
+        length_min = length;
+        for (int j = 0; j < 3; j++)
+          lengths_out[j] = lengths[j];
+      }
     }
   }
 
-  x_start = x_s1 + turning_radius * cos(t_start);
-  y_start = y_s1 + turning_radius * sin(t_start);
-  x_end = x_s2 + turning_radius * cos(t_end);
-  y_end = y_s2 + turning_radius * sin(t_end);
+  return word_min;
+}
 
-  int direction_s1 = 1;
-  if ((comb_no == 2) || (comb_no == 4)) {
-    direction_s1 = -1;
-  }
-  int direction_s2 = 1;
-  if ((comb_no == 1) || (comb_no == 4)) {
-    direction_s2 = -1;
-  }
+int Dubins::solve_dubins(StateDubins *state_ini, StateDubins *state_fin,
+                         double *lengths_out) {
 
-  double t_increment_s1 = direction_s1 * (t_start - t_s1);
-  double t_increment_s2 = direction_s2 * (t_s2 - t_end);
+  // Transform to the frame where the initial position is the origin, the
+  // final position is on the x axis and the turning radius is one.
+  double dx = (*state_fin)[0] - (*state_ini)[0];
+  double dy = (*state_fin)[1] - (*state_ini)[1];
+  double d = sqrt(dx * dx + dy * dy) / turning_radius;
+  double theta = (d > 0.0) ? atan2(dy, dx) : 0.0;
+  double alpha = mod_2pi((*state_ini)[2] - theta);
+  double beta = mod_2pi((*state_fin)[2] - theta);
 
-  while (t_increment_s1 < 0)
-    t_increment_s1 += 2.0 * M_PI;
-  while (t_increment_s1 > 2.0 * M_PI)
-    t_increment_s1 -= 2.0 * M_PI;
+  return dubins_shortest(d, alpha, beta, sin(alpha), cos(alpha), sin(beta),
+                         cos(beta), DBL_MAX, lengths_out);
+}
 
-  while (t_increment_s2 < 0)
-    t_increment_s2 += 2.0 * M_PI;
-  while (t_increment_s2 > 2.0 * M_PI)
-    t_increment_s2 -= 2.0 * M_PI;
+int Dubins::lengths_batch(StateDubins *state_in, bool from_state,
+                          int num_states, const double *x_in,
+                          const double *y_in, const double *t_in,
+                          const double *lengths_max_in, double *lengths_out) {
+
+  // The trigonometric functions of the shared state are computed once.
+  double x = (*state_in)[0];
+  double y = (*state_in)[1];
+  double t = (*state_in)[2];
+  double sin_t = sin(t);
+  double cos_t = cos(t);
+  double sign = from_state ? 1.0 : -1.0;
+
+  double lengths[3];
+
+  for (int i = 0; i < num_states; i++) {
+
+    // 1. Transform to the normalized frame. Every state takes the sine and
+    // the cosine of its heading. The ones of the headings relative to the
+    // line between the positions are their rotations, so the bound takes
+    // no arc tangent.
+    double dx = sign * (x_in[i] - x);
+    double dy = sign * (y_in[i] - y);
+    double distance = sqrt(dx * dx + dy * dy);
+    double d = distance / turning_radius;
+    double cos_theta = (distance > 0.0) ? dx / distance : 1.0;
+    double sin_theta = (distance > 0.0) ? dy / distance : 0.0;
+
+    double sin_i = sin(t_in[i]);
+    double cos_i = cos(t_in[i]);
+    double sin_ini = from_state ? sin_t : sin_i;
+    double cos_ini = from_state ? cos_t : cos_i;
+    double sin_fin = from_state ? sin_i : sin_t;
+    double cos_fin = from_state ? cos_i : cos_t;
+
+    double sa = sin_ini * cos_theta - cos_ini * sin_theta;
+    double ca = cos_ini * cos_theta + sin_ini * sin_theta;
+    double sb = sin_fin * cos_theta - cos_fin * sin_theta;
+    double cb = cos_fin * cos_theta + sin_fin * sin_theta;
+
+    // 2. Skip the paths whose bound is already too long.
+    double length_max = DBL_MAX;
+    if (lengths_max_in) {
+      double bound = dubins_bound(d, sa, ca, sb, cb);
+      length_max = lengths_max_in[i] / turning_radius;
+      if (bound >= length_max) {
+        lengths_out[i] = bound * turning_radius;
+        continue;
+      }
+    }
 
-  if (((t_increment_s1 > M_PI) && (t_increment_s2 > M_PI)) ||
-      ((t_increment_s1 > 3 * M_PI_2) || (t_increment_s2 > 3 * M_PI_2))) {
-    return -1.0;
+    // 3. Solve for the shortest path, skipping the words that are too long.
+    // Only the states that pass the bound take the arc tangents of their
+    // relative headings.
+    double alpha = atan2(sa, ca);
+    double beta = atan2(sb, cb);
+    if (dubins_shortest(d, mod_2pi(alpha), mod_2pi(beta), sa, ca, sb, cb,
+                        length_max, lengths) >= 0)
+      lengths_out[i] =
+          (lengths[0] + lengths[1] + lengths[2]) * turning_radius;
+    else
+      lengths_out[i] = length_max * turning_radius;
   }
 
-  double total_distance_travel =
-      (t_increment_s1 + t_increment_s2) * turning_radius + distance;
-
-  double distance_limit = DISTANCE_LIMIT;
-
-  if (fully_extends)
-    *fully_extends = 0;
-
-  if (list_states) {
-    // Generate states/inputs
+  return 1;
+}
 
-    double del_d = DELTA_DISTANCE;
-    double del_t = del_d * turning_radius;
+void Dubins::gather_batch(StateDubins **states_in, int num_states) {
 
-    double t_inc_curr = 0.0;
+  batch_x.resize(num_states);
+  batch_y.resize(num_states);
+  batch_t.resize(num_states);
+  for (int i = 0; i < num_states; i++) {
+    batch_x[i] = (*states_in[i])[0];
+    batch_y[i] = (*states_in[i])[1];
+    batch_t[i] = (*states_in[i])[2];
+  }
+}
 
-    while (t_inc_curr < t_increment_s1) {
-      double t_inc_rel = del_t;
-      t_inc_curr += del_t;
-      if (t_inc_curr > t_increment_s1) {
-        t_inc_rel -= t_inc_curr - t_increment_s1;
-        t_inc_curr = t_increment_s1;
-      }
+int Dubins::lengths_from(StateDubins *state_from_in, int num_states,
+                         const double *x_in, const double *y_in,
+                         const double *t_in, const double *lengths_max_in,
+                         double *lengths_out) {
+  return lengths_batch(state_from_in, true, num_states, x_in, y_in, t_in,
+                       lengths_max_in, lengths_out);
+}
 
-      StateDubins *state_curr = new StateDubins;
-      InputDubins *input_curr = new InputDubins;
+int Dubins::lengths_to(StateDubins *state_towards_in, int num_states,
+                       const double *x_in, const double *y_in,
+                       const double *t_in, const double *lengths_max_in,
+                       double *lengths_out) {
+  return lengths_batch(state_towards_in, false, num_states, x_in, y_in, t_in,
+                       lengths_max_in, lengths_out);
+}
 
-      (*state_curr)[0] =
-          x_s1 + turning_radius * cos(direction_s1 * t_inc_curr + t_s1);
-      (*state_curr)[1] =
-          y_s1 + turning_radius * sin(direction_s1 * t_inc_curr + t_s1);
-      (*state_curr)[2] = direction_s1 * t_inc_curr + t_s1 +
-                         ((direction_s1 == 1) ? M_PI_2 : 3.0 * M_PI_2);
-      while ((*state_curr)[2] < 0)
-        (*state_curr)[2] += 2 * M_PI;
-      while ((*state_curr)[2] > 2 * M_PI)
-        (*state_curr)[2] -= 2 * M_PI;
+int Dubins::solve(StateDubins *state_from_in, StateDubins *state_towards_in,
+                  PathDubins *path_out) {
+
+  // Reuse the last path if it connects the same states.
+  if ((path_last.word >= 0) &&
+      ((*state_from_in)[0] == state_from_last[0]) &&
+      ((*state_from_in)[1] == state_from_last[1]) &&
+      ((*state_from_in)[2] == state_from_last[2]) &&
+      ((*state_towards_in)[0] == state_towards_last[0]) &&
+      ((*state_towards_in)[1] == state_towards_last[1]) &&
+      ((*state_towards_in)[2] == state_towards_last[2])) {
+    *path_out = path_last;
+    return 1;
+  }
 
-      (*input_curr)[0] = t_inc_rel * turning_radius;
-      (*input_curr)[1] = ((comb_no == 1) || (comb_no == 3)) ? -1 : 1;
+  double lengths[3];
+  path_out->word = solve_dubins(state_from_in, state_towards_in, lengths);
+  path_out->turning_radius = turning_radius;
+  if (path_out->word < 0)
+    return 0;
 
-      list_states->push_back(state_curr);
-      list_inputs->push_back(input_curr);
+  for (int j = 0; j < 3; j++)
+    path_out->lengths[j] = lengths[j] * turning_radius;
 
-      if (t_inc_curr * turning_radius > distance_limit) {
+  path_last = *path_out;
+  state_from_last = *state_from_in;
+  state_towards_last = *state_towards_in;
 
-        if (fully_extends)
-          *fully_extends = 0;
+  return 1;
+}
 
-        return total_distance_travel;
-      }
-    }
+int Dubins::materialize(StateDubins *state_from_in,
+                        StateDubins *state_towards_in,
+                        const PathDubins &path_in, double step_in,
+                        int *exact_connection_out,
+                        TrajectoryDubins *trajectory_out,
+                        collision_checker_t *collision_checker_in) {
 
-    double d_inc_curr = 0.0;
-    while (d_inc_curr < distance) {
-      double d_inc_rel = del_d;
-      d_inc_curr += del_d;
-      if (d_inc_curr > distance) {
-        d_inc_rel -= d_inc_curr - distance;
-        d_inc_curr = distance;
-      }
+  if (exact_connection_out)
+    *exact_connection_out = 0;
 
-      StateDubins *state_curr = new StateDubins;
-      InputDubins *input_curr = new InputDubins;
+  if ((path_in.word < 0) || !(step_in > 0.0))
+    return -1;
 
-      (*state_curr)[0] = (x_end - x_start) * d_inc_curr / distance + x_start;
-      (*state_curr)[1] = (y_end - y_start) * d_inc_curr / distance + y_start;
-      (*state_curr)[2] = direction_s1 * t_inc_curr + t_s1 +
-                         ((direction_s1 == 1) ? M_PI_2 : 3.0 * M_PI_2);
-      while ((*state_curr)[2] < 0)
-        (*state_curr)[2] += 2 * M_PI;
-      while ((*state_curr)[2] > 2 * M_PI)
-        (*state_curr)[2] -= 2 * M_PI;
+  // The state that the next step starts from.
+  StateDubins *state_prev = state_from_in;
 
-      (*input_curr)[0] = d_inc_rel;
-      (*input_curr)[1] = 0.0;
+  double radius = path_in.turning_radius;
 
-      list_states->push_back(state_curr);
-      list_inputs->push_back(input_curr);
+  double x = (*state_from_in)[0];
+  double y = (*state_from_in)[1];
+  double t = (*state_from_in)[2];
 
-      if (t_inc_curr * turning_radius + d_inc_curr > distance_limit) {
+  double distance_travel = 0.0;
 
-        if (fully_extends)
-          *fully_extends = 0;
+  for (int j = 0; j < 3; j++) {
 
-        return total_distance_travel;
-      }
-    }
+    int direction = dubins_words[path_in.word][j];
+    double length_segment = path_in.lengths[j];
 
-    double t_inc_curr_prev = t_inc_curr;
-    t_inc_curr = 0.0;
-    while (t_inc_curr < t_increment_s2) {
-      double t_inc_rel = del_t;
-      t_inc_curr += del_t;
-      if (t_inc_curr > t_increment_s2) {
-        t_inc_rel -= t_inc_curr - t_increment_s2;
-        t_inc_curr = t_increment_s2;
+    // Generate the states of the segment from its initial pose, so that
+    // the errors do not accumulate along the segment.
+    double d_inc_curr = 0.0;
+    while (d_inc_curr < length_segment) {
+      double d_inc_rel = step_in;
+      d_inc_curr += step_in;
+      if (d_inc_curr > length_segment) {
+        d_inc_rel -= d_inc_curr - length_segment;
+        d_inc_curr = length_segment;
       }
 
       StateDubins *state_curr = new StateDubins;
       InputDubins *input_curr = new InputDubins;
 
-      (*state_curr)[0] =
-          x_s2 + turning_radius *
-                     cos(direction_s2 * (t_inc_curr - t_increment_s2) + t_s2);
-      (*state_curr)[1] =
-          y_s2 + turning_radius *
-                     sin(direction_s2 * (t_inc_curr - t_increment_s2) + t_s2);
-      (*state_curr)[2] = direction_s2 * (t_inc_curr - t_increment_s2) + t_s2 +
-                         ((direction_s2 == 1) ? M_PI_2 : 3.0 * M_PI_2);
-      while ((*state_curr)[2] < 0)
-        (*state_curr)[2] += 2 * M_PI;
-      while ((*state_curr)[2] > 2 * M_PI)
-        (*state_curr)[2] -= 2 * M_PI;
-
-      (*input_curr)[0] = t_inc_rel * turning_radius;
-      (*input_curr)[1] = ((comb_no == 2) || (comb_no == 3)) ? -1 : 1;
-
-      list_states->push_back(state_curr);
-      list_inputs->push_back(input_curr);
-
-      if ((t_inc_curr_prev + t_inc_curr) * turning_radius + d_inc_curr >
-          distance_limit) {
-
-        if (fully_extends)
-          *fully_extends = 0;
+      if (direction == 0) {
+        (*state_curr)[0] = x + d_inc_curr * cos(t);
+        (*state_curr)[1] = y + d_inc_curr * sin(t);
+        (*state_curr)[2] = t;
+      } else {
+        double t_curr = t + direction * d_inc_curr / radius;
+        (*state_curr)[0] = x + direction * radius * (sin(t_curr) - sin(t));
+        (*state_curr)[1] = y - direction * radius * (cos(t_curr) - cos(t));
+        (*state_curr)[2] = t_curr;
+      }
+      (*state_curr)[2] = mod_2pi((*state_curr)[2]);
 
-        return total_distance_travel;
+      (*input_curr)[0] = d_inc_rel;
+      (*input_curr)[1] = -direction;
+
+      if (collision_checker_in &&
+          (collision_checker_in->check_collision_step(state_prev,
+                                                      state_curr) != 1)) {
+        delete state_curr;
+        delete input_curr;
+        return 0;
       }
-    }
-    //         printf (".");
+      state_prev = state_curr;
 
-    if (fully_extends)
-      *fully_extends = 1;
-  }
+      trajectory_out->list_states.push_back(state_curr);
+      trajectory_out->list_inputs.push_back(input_curr);
 
-  return total_distance_travel;
-}
+      if (distance_travel + d_inc_curr > DISTANCE_LIMIT)
+        return 1;
+    }
 
-double
-Dubins::extend_dubins_all(StateDubins *state_ini,
-                                  StateDubins *state_fin, int *fully_extends,
-                                  std::list<StateDubins *> *list_states_out,
-                                  std::list<InputDubins *> *list_inputs_out) {
-
-  // 1. Compute the centers of all four spheres
-  double ti = (*state_ini)[2];
-  double tf = (*state_fin)[2];
-  double sin_ti = sin(-ti);
-  double cos_ti = cos(-ti);
-  double sin_tf = sin(-tf);
-  double cos_tf = cos(-tf);
-
-  double si_left[3] = {(*state_ini)[0] + turning_radius * sin_ti,
-                       (*state_ini)[1] + turning_radius * cos_ti,
-                       ti + 3 * M_PI_2};
-  double si_right[3] = {(*state_ini)[0] - turning_radius * sin_ti,
-                        (*state_ini)[1] - turning_radius * cos_ti, ti + M_PI_2};
-  double sf_left[3] = {(*state_fin)[0] + turning_radius * sin_tf,
-                       (*state_fin)[1] + turning_radius * cos_tf,
-                       tf + 3 * M_PI_2};
-  double sf_right[3] = {(*state_fin)[0] - turning_radius * sin_tf,
-                        (*state_fin)[1] - turning_radius * cos_tf, tf + M_PI_2};
-
-  // 2. extend all four spheres
-  double times[4];
-
-  times[0] =
-      extend_dubins_spheres(si_left[0], si_left[1], si_left[2], sf_right[0],
-                            sf_right[1], sf_right[2], 1, NULL, NULL, NULL);
-  times[1] =
-      extend_dubins_spheres(si_right[0], si_right[1], si_right[2], sf_left[0],
-                            sf_left[1], sf_left[2], 2, NULL, NULL, NULL);
-  times[2] =
-      extend_dubins_spheres(si_left[0], si_left[1], si_left[2], sf_left[0],
-                            sf_left[1], sf_left[2], 3, NULL, NULL, NULL);
-  times[3] =
-      extend_dubins_spheres(si_right[0], si_right[1], si_right[2], sf_right[0],
-                            sf_right[1], sf_right[2], 4, NULL, NULL, NULL);
-
-  double min_time = DBL_MAX;
-  int comb_min = -1;
-  for (int i = 0; i < 4; i++) {
-    if ((times[i] >= 0.0) && (times[i] < min_time)) {
-      comb_min = i + 1;
-      min_time = times[i];
+    distance_travel += length_segment;
+
+    // Move to the final pose of the segment.
+    if (direction == 0) {
+      x += length_segment * cos(t);
+      y += length_segment * sin(t);
+    } else {
+      double t_next = t + direction * length_segment / radius;
+      x += direction * radius * (sin(t_next) - sin(t));
+      y -= direction * radius * (cos(t_next) - cos(t));
+      t = t_next;
     }
   }
 
-  //     printf ("min comb : %d \n", comb_min);
-
-  int res;
-  switch (comb_min) {
-  case 1:
-    res = extend_dubins_spheres(si_left[0], si_left[1], si_left[2], sf_right[0],
-                                sf_right[1], sf_right[2], 1, fully_extends,
-                                list_states_out, list_inputs_out);
-    //         if (*fully_extends)
-    //             printf (":");
-    return res;
-
-  case 2:
-    res = extend_dubins_spheres(
-        si_right[0], si_right[1], si_right[2], sf_left[0], sf_left[1],
-        sf_left[2], 2, fully_extends, list_states_out, list_inputs_out);
-    //         if (*fully_extends)
-    //             printf (":");
-    return res;
-
-  case 3:
-    res = extend_dubins_spheres(si_left[0], si_left[1], si_left[2], sf_left[0],
-                                sf_left[1], sf_left[2], 3, fully_extends,
-                                list_states_out, list_inputs_out);
-    //         if (*fully_extends)
-    //             printf (":");
-    return res;
-
-  case 4:
-    res = extend_dubins_spheres(
-        si_right[0], si_right[1], si_right[2], sf_right[0], sf_right[1],
-        sf_right[2], 4, fully_extends, list_states_out, list_inputs_out);
-    //         if (*fully_extends)
-    //             printf (":");
-    return res;
-  case -1:
-  default:
-    if (list_states_out) {
-      list_states_out->clear();
-      list_inputs_out->clear();
-    }
-    return -1.0;
+  // The last state is the final state, up to the rounding errors.
+  if (!trajectory_out->list_states.empty()) {
+    StateDubins *state_last = trajectory_out->list_states.back();
+    (*state_last)[0] = (*state_towards_in)[0];
+    (*state_last)[1] = (*state_towards_in)[1];
+    (*state_last)[2] = mod_2pi((*state_towards_in)[2]);
   }
+
+  if (exact_connection_out)
+    *exact_connection_out = 1;
+
+  return 1;
 }
 
 Dubins::Dubins() {}
@@ -376,15 +443,147 @@ int Dubins::extend(
     int *exact_connection_out, TrajectoryDubins *trajectory_out,
     std::list<StateDubins *> *intermediate_vertices_out) {
 
-  if (extend_dubins_all(state_from_in, state_towards_in, exact_connection_out,
-                        &(trajectory_out->list_states),
-                        &(trajectory_out->list_inputs)) < 0.0) {
+  if (exact_connection_out)
+    *exact_connection_out = 0;
+  if (intermediate_vertices_out)
+    intermediate_vertices_out->clear();
 
+  PathDubins path;
+  if (solve(state_from_in, state_towards_in, &path) <= 0)
+    return 0;
+
+  if (materialize(state_from_in, state_towards_in, path, step,
+                  exact_connection_out, trajectory_out) <= 0)
+    return 0;
+
+  // The states coincide, there is no trajectory to add.
+  if (trajectory_out->list_states.empty())
     return 0;
-  }
 
   return 1;
 }
 
-} // namespace dubins
+int Dubins::extend_checked(
+    StateDubins *state_from_in, StateDubins *state_towards_in,
+    collision_checker_t &collision_checker, int *exact_connection_out,
+    TrajectoryDubins *trajectory_out,
+    std::list<StateDubins *> *intermediate_vertices_out) {
+
+  if (exact_connection_out)
+    *exact_connection_out = 0;
+  if (intermediate_vertices_out)
+    intermediate_vertices_out->clear();
+
+  PathDubins path;
+  if (solve(state_from_in, state_towards_in, &path) <= 0)
+    return -1;
+
+  int result = materialize(state_from_in, state_towards_in, path, step,
+                           exact_connection_out, trajectory_out,
+                           &collision_checker);
+  if (result < 0)
+    return result;
+
+  // The states coincide, there is no trajectory to add.
+  if ((result == 1) && trajectory_out->list_states.empty())
+    return -1;
+
+  return result;
+}
+
+double Dubins::cost_lower_bound(StateDubins *state_from_in,
+                                StateDubins *state_towards_in) {
+
+  double dx = (*state_towards_in)[0] - (*state_from_in)[0];
+  double dy = (*state_towards_in)[1] - (*state_from_in)[1];
+
+  return sqrt(dx * dx + dy * dy);
+}
+
+double Dubins::cost_extend_lower_bound(StateDubins *state_from_in,
+                                       StateDubins *state_towards_in) {
+
+  PathDubins path;
+  if (solve(state_from_in, state_towards_in, &path) <= 0)
+    return cost_lower_bound(state_from_in, state_towards_in);
+
+  return path.get_length();
+}
+
+int Dubins::cost_extend_lower_bounds_from(StateDubins *state_from_in,
+                                          StateDubins **states_towards_in,
+                                          int num_states,
+                                          const double *costs_max_in,
+                                          double *bounds_out) {
+
+  gather_batch(states_towards_in, num_states);
+  return lengths_from(state_from_in, num_states, batch_x.data(),
+                      batch_y.data(), batch_t.data(), costs_max_in,
+                      bounds_out);
+}
+
+int Dubins::cost_extend_lower_bounds_to(StateDubins **states_from_in,
+                                        StateDubins *state_towards_in,
+                                        int num_states,
+                                        const double *costs_max_in,
+                                        double *bounds_out) {
+
+  gather_batch(states_from_in, num_states);
+  return lengths_to(state_towards_in, num_states, batch_x.data(),
+                    batch_y.data(), batch_t.data(), costs_max_in, bounds_out);
+}
+
+} // namespace extenders
+
+void PathDubins::evaluate(StateDubins *state_from_in, double distance,
+                          double *x_out, double *y_out, double *t_out) const {
+
+  double x = (*state_from_in)[0];
+  double y = (*state_from_in)[1];
+  double t = (*state_from_in)[2];
+
+  if (distance < 0.0)
+    distance = 0.0;
+
+  for (int j = 0; j < 3; j++) {
+    int direction = extenders::dubins_words[word][j];
+
+    // Stop in the segment that the distance falls in, or at the end of the
+    // path.
+    double length_segment = lengths[j];
+    bool last = (distance <= length_segment) || (j == 2);
+    if (last && (distance < length_segment))
+      length_segment = distance;
+
+    if (direction == 0) {
+      x += length_segment * cos(t);
+      y += length_segment * sin(t);
+    } else {
+      double t_next = t + direction * length_segment / turning_radius;
+      x += direction * turning_radius * (sin(t_next) - sin(t));
+      y -= direction * turning_radius * (cos(t_next) - cos(t));
+      t = t_next;
+    }
+
+    if (last)
+      break;
+    distance -= length_segment;
+  }
+
+  *x_out = x;
+  *y_out = y;
+  *t_out = extenders::mod_2pi(t);
+}
+
+int PathDubins::get_direction(double distance) const {
+
+  int j = 0;
+  while ((j < 2) && (distance > lengths[j])) {
+    distance -= lengths[j];
+    j++;
+  }
+
+  return extenders::dubins_words[word][j];
+}
+
 } // namespace smp
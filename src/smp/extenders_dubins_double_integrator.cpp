@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2018 Sertac Karaman
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <smp/extenders/dubins_double_integrator.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace smp {
+namespace extenders {
+
+// Copies the horizontal pose of a state.
+static inline void project(StateDubinsDoubleIntegrator *state_in,
+                           StateDubins *state_out) {
+  (*state_out)[0] = (*state_in)[0];
+  (*state_out)[1] = (*state_in)[1];
+  (*state_out)[2] = (*state_in)[3];
+}
+
+DubinsDoubleIntegrator::DubinsDoubleIntegrator() {
+  dubins.set_turning_radius(2.5);
+}
+
+DubinsDoubleIntegrator::~DubinsDoubleIntegrator() {}
+
+int DubinsDoubleIntegrator::set_turning_radius(double turning_radius_in) {
+
+  if (!(turning_radius_in > 0.0))
+    return 0;
+
+  dubins.set_turning_radius(turning_radius_in);
+
+  return 1;
+}
+
+int DubinsDoubleIntegrator::set_speed(double speed_in) {
+
+  if (!(speed_in > 0.0))
+    return 0;
+
+  speed = speed_in;
+
+  return 1;
+}
+
+int DubinsDoubleIntegrator::set_velocity_max(double velocity_max_in) {
+
+  if (!(velocity_max_in > 0.0))
+    return 0;
+
+  velocity_max = velocity_max_in;
+
+  return 1;
+}
+
+int DubinsDoubleIntegrator::set_input_max(double input_max_in) {
+
+  if (!(input_max_in > 0.0))
+    return 0;
+
+  input_max = input_max_in;
+
+  return 1;
+}
+
+int DubinsDoubleIntegrator::set_time_step(double time_step_in) {
+
+  if (!(time_step_in > 0.0))
+    return 0;
+
+  time_step = time_step_in;
+
+  return 1;
+}
+
+double DubinsDoubleIntegrator::solve(state_t *state_ini, state_t *state_fin,
+                                     PathDubins *path_out,
+                                     ControlOneAxis *altitude_out) {
+
+  // 1. Solve the path in the horizontal plane
+  StateDubins planar_ini, planar_fin;
+  project(state_ini, &planar_ini);
+  project(state_fin, &planar_fin);
+  if (dubins.solve(&planar_ini, &planar_fin, path_out) <= 0)
+    return -1.0;
+  double time_end = path_out->get_length() / speed;
+
+  // 2. Solve the time-optimal control of the altitude, which must not take
+  //    longer than the horizontal path
+  altitude_out->s_ini[0] = (*state_ini)[2];
+  altitude_out->s_ini[1] = (*state_ini)[4];
+  altitude_out->s_fin[0] = (*state_fin)[2];
+  altitude_out->s_fin[1] = (*state_fin)[4];
+  double time_altitude =
+      altitude_out->solve_time_optimal(input_max, velocity_max);
+  if ((time_altitude < 0.0) || (time_altitude > time_end))
+    return -1.0;
+
+  // 3. Slow the altitude down to arrive at the end of the horizontal path
+  if ((time_altitude < time_end) &&
+      !altitude_out->synchronize(input_max, velocity_max, time_altitude,
+                                 time_end))
+    return -1.0;
+
+  return time_end;
+}
+
+int DubinsDoubleIntegrator::extend_with_optimal_control(
+    state_t *state_ini, state_t *state_fin, trajectory_t *trajectory_out,
+    collision_checker_t *collision_checker_in) {
+
+  PathDubins path;
+  ControlOneAxis altitude;
+  double time_end = solve(state_ini, state_fin, &path, &altitude);
+  if (!(time_end > 0.0))
+    return 0;
+
+  // The switching times of the horizontal path and of the altitude.
+  double times_switch[4] = {path.lengths[0] / speed,
+                            (path.lengths[0] + path.lengths[1]) / speed,
+                            altitude.t_beg, altitude.t_coast_end};
+
+  StateDubins planar_ini;
+  project(state_ini, &planar_ini);
+
+  // The state that the next step starts from.
+  state_t *state_prev = state_ini;
+
+  double t_curr = 0.0;
+  while (t_curr < time_end) {
+
+    // Determine the current time to act. Steps end at every switching time,
+    // however close to the last step, so that the inputs are constant along
+    // every step.
+    double t_next = t_curr + time_step;
+    for (int i = 0; i < 4; i++)
+      if ((times_switch[i] > t_curr) && (times_switch[i] < t_next))
+        t_next = times_switch[i];
+    if (t_next > time_end)
+      t_next = time_end;
+
+    // Calculate the states/inputs at the current time
+    state_t *state_new = new state_t;
+    input_t *input_new = new input_t;
+
+    path.evaluate(&planar_ini, speed * t_next, &(*state_new)[0],
+                  &(*state_new)[1], &(*state_new)[3]);
+    altitude.evaluate(t_next, &(*state_new)[2], &(*state_new)[4]);
+
+    double t_mid = (t_curr + t_next) / 2.0;
+    (*input_new)[0] = t_next - t_curr;
+    (*input_new)[1] = -path.get_direction(speed * t_mid);
+    (*input_new)[2] = altitude.input(t_mid);
+
+    // The last state is the final state, up to the rounding of the timing.
+    if (t_next >= time_end)
+      *state_new = *state_fin;
+
+    // Stop at the first step that collides
+    if (collision_checker_in &&
+        (collision_checker_in->check_collision_step(state_prev, state_new) !=
+         1)) {
+      delete state_new;
+      delete input_new;
+      return -1;
+    }
+    state_prev = state_new;
+
+    // Store the states/inputs to the trajectory
+    trajectory_out->list_states.push_back(state_new);
+    trajectory_out->list_inputs.push_back(input_new);
+
+    t_curr = t_next;
+  }
+
+  return 1;
+}
+
+int DubinsDoubleIntegrator::extend(
+    state_t *state_from_in, state_t *state_towards_in,
+    int *exact_connection_out, trajectory_t *trajectory_out,
+    std::list<state_t *> *intermediate_vertices_out) {
+
+  if (exact_connection_out)
+    *exact_connection_out = 0;
+  if (intermediate_vertices_out)
+    intermediate_vertices_out->clear();
+  if (extend_with_optimal_control(state_from_in, state_towards_in,
+                                  trajectory_out) != 1)
+    return 0;
+  if (exact_connection_out)
+    *exact_connection_out = 1;
+  return 1;
+}
+
+int DubinsDoubleIntegrator::extend_checked(
+    state_t *state_from_in, state_t *state_towards_in,
+    collision_checker_t &collision_checker, int *exact_connection_out,
+    trajectory_t *trajectory_out,
+    std::list<state_t *> *intermediate_vertices_out) {
+
+  if (exact_connection_out)
+    *exact_connection_out = 0;
+  if (intermediate_vertices_out)
+    intermediate_vertices_out->clear();
+  int result = extend_with_optimal_control(state_from_in, state_towards_in,
+                                           trajectory_out, &collision_checker);
+  if (result == 0)
+    return -1;
+
+  // The trajectory holds the steps before the collision.
+  if (result < 0)
+    return 0;
+
+  if (exact_connection_out)
+    *exact_connection_out = 1;
+  return 1;
+}
+
+double DubinsDoubleIntegrator::extend_time(state_t *state_from_in,
+                                           state_t *state_towards_in) {
+
+  PathDubins path;
+  ControlOneAxis altitude;
+
+  return solve(state_from_in, state_towards_in, &path, &altitude);
+}
+
+double DubinsDoubleIntegrator::cost_lower_bound(state_t *state_from_in,
+                                                state_t *state_towards_in) {
+
+  double dx = (*state_towards_in)[0] - (*state_from_in)[0];
+  double dy = (*state_towards_in)[1] - (*state_from_in)[1];
+  double time = sqrt(dx * dx + dy * dy) / speed;
+
+  double s_ini[2] = {(*state_from_in)[2], (*state_from_in)[4]};
+  double s_fin[2] = {(*state_towards_in)[2], (*state_towards_in)[4]};
+  double time_altitude = extend_with_time_optimal_control_one_axis(
+      s_ini, s_fin, input_max, velocity_max, NULL, NULL, NULL, NULL, NULL);
+
+  return std::max(time, time_altitude);
+}
+
+double DubinsDoubleIntegrator::cost_extend_lower_bound(
+    state_t *state_from_in, state_t *state_towards_in) {
+
+  double time = extend_time(state_from_in, state_towards_in);
+  if (time < 0.0)
+    return cost_lower_bound(state_from_in, state_towards_in);
+
+  return time;
+}
+
+int DubinsDoubleIntegrator::cost_extend_lower_bounds_batch(
+    state_t *state_in, bool from_state, state_t **states_in, int num_states,
+    const double *costs_max_in, double *bounds_out) {
+
+  batch_x.resize(num_states);
+  batch_y.resize(num_states);
+  batch_t.resize(num_states);
+  for (int i = 0; i < num_states; i++) {
+    batch_x[i] = (*states_in[i])[0];
+    batch_y[i] = (*states_in[i])[1];
+    batch_t[i] = (*states_in[i])[3];
+  }
+
+  // The lengths need only be exact below the costs, times the speed.
+  const double *lengths_max = NULL;
+  if (costs_max_in) {
+    batch_lengths_max.resize(num_states);
+    for (int i = 0; i < num_states; i++)
+      batch_lengths_max[i] = costs_max_in[i] * speed;
+    lengths_max = batch_lengths_max.data();
+  }
+
+  StateDubins planar;
+  project(state_in, &planar);
+  int result =
+      from_state
+          ? dubins.lengths_from(&planar, num_states, batch_x.data(),
+                                batch_y.data(), batch_t.data(), lengths_max,
+                                bounds_out)
+          : dubins.lengths_to(&planar, num_states, batch_x.data(),
+                              batch_y.data(), batch_t.data(), lengths_max,
+                              bounds_out);
+  if (result <= 0)
+    return result;
+
+  for (int i = 0; i < num_states; i++)
+    bounds_out[i] /= speed;
+
+  return 1;
+}
+
+int DubinsDoubleIntegrator::cost_extend_lower_bounds_from(
+    state_t *state_from_in, state_t **states_towards_in, int num_states,
+    const double *costs_max_in, double *bounds_out) {
+  return cost_extend_lower_bounds_batch(state_from_in, true,
+                                        states_towards_in, num_states,
+                                        costs_max_in, bounds_out);
+}
+
+int DubinsDoubleIntegrator::cost_extend_lower_bounds_to(
+    state_t **states_from_in, state_t *state_towards_in, int num_states,
+    const double *costs_max_in, double *bounds_out) {
+  return cost_extend_lower_bounds_batch(state_towards_in, false,
+                                        states_from_in, num_states,
+                                        costs_max_in, bounds_out);
+}
+
+} // namespace extenders
+} // namespace smp
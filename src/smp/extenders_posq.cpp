@@ -3,18 +3,17 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-#include <boost/range.hpp>
-#include <boost/shared_array.hpp>
+// Time step of the controller simulation in extend().
+#define POSQ_TIME_STEP 0.1
 
 #include <cmath>
-#include <cstdlib>
 
 #include <smp/extenders/posq.hpp>
 
 namespace smp {
 namespace extenders {
 
-double PosQ::set_angle_to_range(double alpha, double min) {
+double PosQ::set_angle_to_range(double alpha, double min) const {
 
   while (alpha >= min + 2.0 * M_PI) {
     alpha -= 2.0 * M_PI;
@@ -25,7 +24,7 @@ double PosQ::set_angle_to_range(double alpha, double min) {
   return alpha;
 }
 
-double PosQ::diff_angle_unwrap(double alpha1, double alpha2) {
+double PosQ::diff_angle_unwrap(double alpha1, double alpha2) const {
   double delta;
 
   // normalize angles alpha1 and alpha2
@@ -46,7 +45,7 @@ double PosQ::diff_angle_unwrap(double alpha1, double alpha2) {
   return delta;
 }
 
-double PosQ::normangle(double a, double mina) {
+double PosQ::normangle(double a, double mina) const {
 
   double ap, minap;
   ap = a;
@@ -61,7 +60,7 @@ double PosQ::normangle(double a, double mina) {
   return ap;
 }
 
-double PosQ::f(double rho) {
+double PosQ::f(double rho) const {
 
   double Kv;
   /// New implementation  Kv= max atanh(rho)/rho
@@ -74,9 +73,9 @@ double PosQ::f(double rho) {
   //  return (2*v0/M_PI)*atan((M_PI/(2*v0))*rho);
 }
 
-double *PosQ::posctrlstep(double x_c, double y_c, double t_c, double x_end,
-                          double y_end, double t_end, double ct, double b,
-                          int dir) {
+void PosQ::posctrlstep(double x_c, double y_c, double t_c, double x_end,
+                       double y_end, double t_end, double b, int dir,
+                       double *beta_inout, double *result_out) const {
 
   /** This function will generate a vector of double as output:
 
@@ -88,38 +87,18 @@ double *PosQ::posctrlstep(double x_c, double y_c, double t_c, double x_end,
 
   **/
 
-  static double oldBeta, controllerType;
-
-  double Krho, Kalpha, Kbeta, Kphi, Vmax, RhoThreshold1, RhoThreshold2,
-      RhoEndCondition, PhiEndCondition;
+  double Krho, Kalpha, Kbeta, Vmax, RhoEndCondition;
   // [1 3 -1 -1]
-  Krho = 1;
-  Kalpha = 3;
-  Kbeta = -1;
-  Kphi = -1;
-  Vmax = Krho;
-  //  RhoThreshold1   = 0.04;
-  RhoThreshold1 = 0.005;
-
-  RhoThreshold2 = 0.02;
-  //  RhoThreshold2   = 0.2;
+  Krho = gain_rho;
+  Kalpha = gain_alpha;
+  Kbeta = gain_beta;
+  Vmax = velocity_max;
+
   /// The RRT* edges' lenght is related to the RhoEndCondition
 
   RhoEndCondition = 0.05;
 
-  /// the PhiEndCondition has to be setted properly,
-  /// small Value, local minima can occur, tested --> greater than 35*M_PI/180
-
-  //  PhiEndCondition = 1*M_PI/180; [NOT IN THE ASTOLFI PAPER :)]
-  PhiEndCondition = 50 * M_PI / 180;
-
-  if (ct == 0) {
-    oldBeta = 0;
-    controllerType = 1;
-  }
-
-  double dx, dy, rho, fRho, alpha, phi, beta, v, w, vl, vr, eot, vi, di;
-  vi = 0.1;
+  double dx, dy, rho, fRho, alpha, phi, beta, v, w, vl, vr, eot;
   // rho
   eot = 1;
   dx = x_end - x_c;
@@ -162,10 +141,10 @@ double *PosQ::posctrlstep(double x_c, double y_c, double t_c, double x_end,
 
   beta = normangle(phi - alpha, -M_PI);
 
-  if ((abs(oldBeta - beta) > M_PI)) {
-    beta = oldBeta;
+  if (fabs(*beta_inout - beta) > M_PI) {
+    beta = *beta_inout;
   }
-  oldBeta = beta;
+  *beta_inout = beta;
 
   // set speed
 
@@ -187,7 +166,7 @@ double *PosQ::posctrlstep(double x_c, double y_c, double t_c, double x_end,
 
   vl = v - w * b / 2;
 
-  if (abs(vl) > Vmax) {
+  if (fabs(vl) > Vmax) {
 
     if (vl < 0) {
       vl = Vmax * -1;
@@ -198,7 +177,7 @@ double *PosQ::posctrlstep(double x_c, double y_c, double t_c, double x_end,
 
   vr = v + w * b / 2;
 
-  if (abs(vr) > Vmax) {
+  if (fabs(vr) > Vmax) {
     if (vr < 0) {
       vr = Vmax * -1;
     } else {
@@ -206,174 +185,246 @@ double *PosQ::posctrlstep(double x_c, double y_c, double t_c, double x_end,
     }
   }
 
-  result[0] = vl;
-  result[1] = vr;
-  result[2] = v;
-  result[3] = w;
-  result[4] = eot;
-
-  return result;
+  result_out[0] = vl;
+  result_out[1] = vr;
+  result_out[2] = v;
+  result_out[3] = w;
+  result_out[4] = eot;
 }
 
-double PosQ::posctrl(StatePosQ *state_ini, StatePosQ *state_fin, int dir,
-                     double b, double dt,
-                     std::list<StatePosQ *> *list_states_out,
-                     std::list<InputPosQ *> *list_inputs_out) {
-
-  double sl, sr, oldSl, oldSr, t, eot, dSl, dSr, dSm, dSd, vl, vr, enc_l, enc_r;
-
-  enc_l = 0;
-  enc_r = 0;
-  sl = 0;
-  sr = 0;
-  oldSl = 0;
-  oldSr = 0;
-  eot = 0;
-  t = 0;
-  vl = 0;
-  vr = 0;
-
-  double x, y, th;
-  x = (*state_ini)[0];
-  y = (*state_ini)[1];
-  th = (*state_ini)[2];
-
-  this->xi = x;
-  this->yi = y;
+int PosQ::rollout(StatePosQ *state_from_in, StatePosQ *state_towards_in,
+                  int dir,
+                  std::vector<StatePosQ> *states_out,
+                  std::vector<InputPosQ> *inputs_out, double *distance_out,
+                  collision_checker_t *collision_checker_in) const {
+
+  const double dt = POSQ_TIME_STEP;
+  const double b = wheel_base;
+
+  // The state of the controller: the wheel positions before and after the
+  // last step, and the angle beta of the last step.
+  double sl = 0.0, sr = 0.0, oldSl = 0.0, oldSr = 0.0;
+  double beta = 0.0;
+  double result[5];
+
+  double dSl, dSr, dSm, dSd;
+
+  double x = (*state_from_in)[0];
+  double y = (*state_from_in)[1];
+  double th = (*state_from_in)[2];
+
+  states_out->clear();
+  inputs_out->clear();
+
+  StatePosQ curr;
+  InputPosQ ve;
+
+  double dist = 0.0;
+
+  for (int step = 0; step < steps_max; step++) {
+    // calculate distance for both wheels
+    dSl = sl - oldSl;
+    dSr = sr - oldSr;
+    dSm = (dSl + dSr) / 2;
+    dSd = (dSr - dSl) / b;
+
+    curr[0] = x + dSm * cos(th + dSd / 2);
+    curr[1] = y + dSm * sin(th + dSd / 2);
+    curr[2] = normangle(th + dSd, -M_PI);
+
+    posctrlstep(curr[0], curr[1], curr[2], (*state_towards_in)[0],
+                (*state_towards_in)[1], (*state_towards_in)[2], b, dir, &beta,
+                result);
+
+    // Save the velocity commands
+    ve[0] = result[2];
+    ve[1] = result[3];
+
+    // keep track of previous wheel position
+    oldSl = sl;
+    oldSr = sr;
+
+    // increase encoder values
+    sl += dt * result[0];
+    sr += dt * result[1];
+
+    float dxl, dyl;
+    dxl = (*state_towards_in)[0] - curr[0];
+    dyl = (*state_towards_in)[1] - curr[1];
+    dist = sqrt(dxl * dxl + dyl * dyl);
+
+    // Stop at the first step that collides. The first state is the initial
+    // state, which needs no check.
+    if (collision_checker_in && (step > 0) &&
+        (collision_checker_in->check_collision_step(&states_out->back(),
+                                                    &curr) != 1)) {
+      *distance_out = dist;
+      return -1;
+    }
 
-  double vv, ww, ths;
-  vv = 0;
-  ww = 0;
-  ths = 0.1;
+    // Add current values to the Trajectory
+    states_out->push_back(curr);
+    inputs_out->push_back(ve);
 
-  double dist;
-  dist = 0;
+    // save the state for the next sample
+    x = curr[0];
+    y = curr[1];
+    th = curr[2];
 
-  if (list_states_out) {
+    if (result[4] == 1) {
 
-    while (eot == 0) {
-      // calculate distance for both wheels
+      /// save the last state!!!
       dSl = sl - oldSl;
       dSr = sr - oldSr;
       dSm = (dSl + dSr) / 2;
-
       dSd = (dSr - dSl) / b;
-      StatePosQ *curr = new StatePosQ;
-      InputPosQ *ve = new InputPosQ;
-
-      (*curr)[0] = x + dSm * cos(th + dSd / 2);
-      (*curr)[1] = y + dSm * sin(th + dSd / 2);
-      (*curr)[2] = normangle(th + dSd, -M_PI);
-
-      intRes = posctrlstep((*curr)[0], (*curr)[1], (*curr)[2], (*state_fin)[0],
-                           (*state_fin)[1], (*state_fin)[2], t, b, dir);
-      // Save the velocity commands,eot
-      vv = intRes[2];
-      ww = intRes[3];
-      (*ve)[0] = intRes[2];
-      (*ve)[1] = intRes[3];
-      eot = intRes[4];
-      vl = intRes[0];
-      vr = intRes[1];
-
-      // Increase the timer
-      t = t + dt;
-
-      // keep track of previous wheel position
-      oldSl = sl;
-      oldSr = sr;
-
-      // increase encoder values
-      enc_l = enc_l + dt * vl;
-      enc_r = enc_r + dt * vr;
-
-      sl = enc_l;
-      sr = enc_r;
-
-      //
-      float dxl, dyl;
-      dxl = (*state_fin)[0] - (*curr)[0];
-      dyl = (*state_fin)[1] - (*curr)[1];
-      dist = sqrt(dxl * dxl + dyl * dyl);
-
-      // save the state for the next sample
-      x = (*curr)[0];
-      y = (*curr)[1];
-      th = (*curr)[2];
-
-      if (eot == 1) {
-
-        /// save the last state!!!
-        StatePosQ *save = new StatePosQ;
-        InputPosQ *vesave = new InputPosQ;
-        (*vesave)[0] = intRes[2];
-        (*vesave)[1] = intRes[3];
-        dSl = sl - oldSl;
-        dSr = sr - oldSr;
-        dSm = (dSl + dSr) / 2;
-        dSd = (dSr - dSl) / b;
-        (*save)[0] = x + dSm * cos(th + dSd / 2);
-        (*save)[1] = y + dSm * sin(th + dSd / 2);
-        (*save)[2] = normangle(th + dSd, -M_PI);
-        // Add current values to the Trajectory
-        list_states_out->push_back((curr));
-        list_inputs_out->push_back((ve));
-
-        list_states_out->push_back((save));
-        list_inputs_out->push_back((vesave));
-
-      } else
-
-      {
-        // Add current values to the Trajectory
-        list_states_out->push_back((curr));
-        list_inputs_out->push_back((ve));
+      curr[0] = x + dSm * cos(th + dSd / 2);
+      curr[1] = y + dSm * sin(th + dSd / 2);
+      curr[2] = normangle(th + dSd, -M_PI);
+
+      if (collision_checker_in &&
+          (collision_checker_in->check_collision_step(&states_out->back(),
+                                                      &curr) != 1)) {
+        *distance_out = dist;
+        return -1;
       }
+
+      states_out->push_back(curr);
+      inputs_out->push_back(ve);
+
+      *distance_out = dist;
+      return 1;
     }
   }
-  return dist;
-}
 
-PosQ::PosQ() {
-  result = (double *)malloc(sizeof(double) * 5);
-  intRes = (double *)malloc(sizeof(double) * 5);
+  *distance_out = dist;
+  return 0;
 }
 
+PosQ::PosQ() {}
+
 PosQ::~PosQ() {}
 
+int PosQ::set_gains(double gain_rho_in, double gain_alpha_in,
+                    double gain_beta_in) {
+
+  if (!(gain_rho_in > 0.0))
+    return 0;
+
+  gain_rho = gain_rho_in;
+  gain_alpha = gain_alpha_in;
+  gain_beta = gain_beta_in;
+
+  return 1;
+}
+
+int PosQ::set_velocity_max(double velocity_max_in) {
+
+  if (!(velocity_max_in > 0.0))
+    return 0;
+
+  velocity_max = velocity_max_in;
+
+  return 1;
+}
+
+double PosQ::get_step_max() const {
+
+  return velocity_max * POSQ_TIME_STEP;
+}
+
+int PosQ::set_wheel_base(double wheel_base_in) {
+
+  if (!(wheel_base_in > 0.0))
+    return 0;
+
+  wheel_base = wheel_base_in;
+
+  return 1;
+}
+
+int PosQ::set_steps_max(int steps_max_in) {
+
+  if (steps_max_in <= 0)
+    return 0;
+
+  steps_max = steps_max_in;
+
+  return 1;
+}
+
 int PosQ::extend(StatePosQ *state_from_in, StatePosQ *state_towards_in,
                  int *exact_connection_out, trajectory_t *trajectory_out,
                  std::list<StatePosQ *> *intermediate_vertices_out) {
 
-  int dir;
-  dir = 1;
+  return extend_rollout(state_from_in, state_towards_in, NULL,
+                        exact_connection_out, trajectory_out,
+                        intermediate_vertices_out);
+}
 
-  double b, d, myEps;
-  const double dt = 0.1;
+int PosQ::extend_checked(StatePosQ *state_from_in,
+                         StatePosQ *state_towards_in,
+                         collision_checker_t &collision_checker,
+                         int *exact_connection_out,
+                         trajectory_t *trajectory_out,
+                         std::list<StatePosQ *> *intermediate_vertices_out) {
+
+  int result = extend_rollout(state_from_in, state_towards_in,
+                              &collision_checker, exact_connection_out,
+                              trajectory_out, intermediate_vertices_out);
+  if (result == 1)
+    return 1;
+
+  // The rollout collided, and the trajectory holds the steps before it.
+  if (result < 0)
+    return 0;
 
-  T = 0.31;
-  /// Base
-  b = 0.4;
+  return -1;
+}
 
-  myEps = 0.50;
+int PosQ::extend_rollout(StatePosQ *state_from_in,
+                         StatePosQ *state_towards_in,
+                         collision_checker_t *collision_checker_in,
+                         int *exact_connection_out,
+                         trajectory_t *trajectory_out,
+                         std::list<StatePosQ *> *intermediate_vertices_out) {
+
+  const int dir = 1;
+  const double myEps = 0.50;
 
-  //   cout<<"call posctrl /...."<<endl<<endl;
   intermediate_vertices_out->clear();
   trajectory_out->clear();
-  d = posctrl(state_from_in, state_towards_in, dir, b, dt,
-              &(trajectory_out->list_states), &(trajectory_out->list_inputs));
 
-  if (d < myEps) {
+  // Each thread keeps its own rollout storage, which is reused by the
+  // later extensions of the thread.
+  static thread_local std::vector<StatePosQ> states;
+  static thread_local std::vector<InputPosQ> inputs;
+
+  double d;
+  int reached = rollout(state_from_in, state_towards_in, dir, &states,
+                        &inputs, &d, collision_checker_in);
+
+  for (size_t i = 0; i < states.size(); i++) {
+    trajectory_out->list_states.push_back(new StatePosQ(states[i]));
+    trajectory_out->list_inputs.push_back(new InputPosQ(inputs[i]));
+  }
+
+  if ((reached > 0) && (d < myEps)) {
     (*exact_connection_out) = 1;
     return 1;
+  }
 
-  } else
+  (*exact_connection_out) = 0;
+  return (reached < 0) ? -1 : 0;
+}
 
-  {
+double PosQ::cost_lower_bound(StatePosQ *state_from_in,
+                              StatePosQ *state_towards_in) {
 
-    (*exact_connection_out) = 0;
-    return 0;
-  }
+  double dx = (*state_towards_in)[0] - (*state_from_in)[0];
+  double dy = (*state_towards_in)[1] - (*state_from_in)[1];
+
+  return sqrt(dx * dx + dy * dy) / POSQ_TIME_STEP;
 }
 } // namespace extenders
 } // namespace smp
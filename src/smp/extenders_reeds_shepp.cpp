@@ -0,0 +1,695 @@
+/*
+ * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#define DISTANCE_LIMIT 100.0
+
+#ifndef DBL_MAX
+#define DBL_MAX 10000000000000000.0
+#endif
+
+// Tolerance of the conditions on the signs of the segment lengths.
+#define RS_ZERO 1e-12
+
+#include <smp/extenders/reeds_shepp.hpp>
+
+#include <cmath>
+#include <cstdlib>
+
+namespace smp {
+namespace extenders {
+
+// Turn directions of the five segments of every path type, 1 for a left
+// turn, -1 for a right turn, 0 for a straight segment and 2 for no segment.
+// The types are the ones of the base formulas of Reeds and Shepp, and of
+// their reflections.
+static const int reeds_shepp_types[18][5] = {
+    {1, -1, 1, 2, 2},   {-1, 1, -1, 2, 2},  {1, -1, 1, -1, 2},
+    {-1, 1, -1, 1, 2},  {1, -1, 0, 1, 2},   {-1, 1, 0, -1, 2},
+    {1, 0, -1, 1, 2},   {-1, 0, 1, -1, 2},  {1, -1, 0, -1, 2},
+    {-1, 1, 0, 1, 2},   {-1, 0, -1, 1, 2},  {1, 0, 1, -1, 2},
+    {1, 0, -1, 2, 2},   {-1, 0, 1, 2, 2},   {1, 0, 1, 2, 2},
+    {-1, 0, -1, 2, 2},  {1, -1, 0, 1, -1},  {-1, 1, 0, -1, 1}};
+
+// Wraps an angle to (-pi, pi].
+static inline double mod_pi(double angle) {
+  double wrapped = fmod(angle, 2.0 * M_PI);
+  if (wrapped < -M_PI)
+    wrapped += 2.0 * M_PI;
+  else if (wrapped > M_PI)
+    wrapped -= 2.0 * M_PI;
+  return wrapped;
+}
+
+// Wraps an angle to [0, 2 pi).
+static inline double mod_2pi(double angle) {
+  return angle - 2.0 * M_PI * floor(angle / (2.0 * M_PI));
+}
+
+static inline void polar(double x, double y, double &r, double &theta) {
+  r = sqrt(x * x + y * y);
+  theta = atan2(y, x);
+}
+
+static inline void tau_omega(double u, double v, double xi, double eta,
+                             double phi, double &tau, double &omega) {
+  double delta = mod_pi(u - v);
+  double a = sin(u) - sin(delta);
+  double b = cos(u) - cos(delta) - 1.0;
+  double t1 = atan2(eta * a - xi * b, xi * a + eta * b);
+  double t2 = 2.0 * (cos(delta) - cos(v) - cos(u)) + 3.0;
+  tau = (t2 < 0.0) ? mod_pi(t1 + M_PI) : mod_pi(t1);
+  omega = mod_pi(tau - u + v - phi);
+}
+
+// The base formulas of Reeds and Shepp, numbered as in their paper, for the
+// final state (x, y, phi) with the sine and cosine of phi. The letters give
+// the turn direction of every segment, and p and m whether the segment is
+// driven forwards or backwards.
+
+// Formula 8.1: LpSpLp.
+static inline bool lp_sp_lp(double x, double y, double phi, double sp,
+                            double cp, double &t, double &u, double &v) {
+  polar(x - sp, y - 1.0 + cp, u, t);
+  if (t >= -RS_ZERO) {
+    v = mod_pi(phi - t);
+    if (v >= -RS_ZERO)
+      return true;
+  }
+  return false;
+}
+
+// Formula 8.2: LpSpRp.
+static inline bool lp_sp_rp(double x, double y, double phi, double sp,
+                            double cp, double &t, double &u, double &v) {
+  double t1, u1;
+  polar(x + sp, y - 1.0 - cp, u1, t1);
+  u1 = u1 * u1;
+  if (u1 >= 4.0) {
+    u = sqrt(u1 - 4.0);
+    t = mod_pi(t1 + atan2(2.0, u));
+    v = mod_pi(t - phi);
+    return (t >= -RS_ZERO) && (v >= -RS_ZERO);
+  }
+  return false;
+}
+
+// Formulas 8.3 and 8.4: LpRmL.
+static inline bool lp_rm_l(double x, double y, double phi, double sp,
+                           double cp, double &t, double &u, double &v) {
+  double xi = x - sp;
+  double eta = y - 1.0 + cp;
+  double u1, theta;
+  polar(xi, eta, u1, theta);
+  if (u1 <= 4.0) {
+    u = -2.0 * asin(0.25 * u1);
+    t = mod_pi(theta + 0.5 * u + M_PI);
+    v = mod_pi(phi - t + u);
+    return (t >= -RS_ZERO) && (u <= RS_ZERO);
+  }
+  return false;
+}
+
+// Formula 8.7: LpRupLumRm.
+static inline bool lp_rup_lum_rm(double x, double y, double phi, double sp,
+                                 double cp, double &t, double &u,
+                                 double &v) {
+  double xi = x + sp;
+  double eta = y - 1.0 - cp;
+  double rho = 0.25 * (2.0 + sqrt(xi * xi + eta * eta));
+  if (rho <= 1.0) {
+    u = acos(rho);
+    tau_omega(u, -u, xi, eta, phi, t, v);
+    return (t >= -RS_ZERO) && (v <= RS_ZERO);
+  }
+  return false;
+}
+
+// Formula 8.8: LpRumLumRp.
+static inline bool lp_rum_lum_rp(double x, double y, double phi, double sp,
+                                 double cp, double &t, double &u,
+                                 double &v) {
+  double xi = x + sp;
+  double eta = y - 1.0 - cp;
+  double rho = (20.0 - xi * xi - eta * eta) / 16.0;
+  if ((rho >= 0.0) && (rho <= 1.0)) {
+    u = -acos(rho);
+    if (u >= -0.5 * M_PI) {
+      tau_omega(u, u, xi, eta, phi, t, v);
+      return (t >= -RS_ZERO) && (v >= -RS_ZERO);
+    }
+  }
+  return false;
+}
+
+// Formula 8.9: LpRmSmLm.
+static inline bool lp_rm_sm_lm(double x, double y, double phi, double sp,
+                               double cp, double &t, double &u, double &v) {
+  double xi = x - sp;
+  double eta = y - 1.0 + cp;
+  double rho, theta;
+  polar(xi, eta, rho, theta);
+  if (rho >= 2.0) {
+    double r = sqrt(rho * rho - 4.0);
+    u = 2.0 - r;
+    t = mod_pi(theta + atan2(r, -2.0));
+    v = mod_pi(phi - 0.5 * M_PI - t);
+    return (t >= -RS_ZERO) && (u <= RS_ZERO) && (v <= RS_ZERO);
+  }
+  return false;
+}
+
+// Formula 8.10: LpRmSmRm.
+static inline bool lp_rm_sm_rm(double x, double y, double phi, double sp,
+                               double cp, double &t, double &u, double &v) {
+  double xi = x + sp;
+  double eta = y - 1.0 - cp;
+  double rho, theta;
+  polar(-eta, xi, rho, theta);
+  if (rho >= 2.0) {
+    t = theta;
+    u = 2.0 - rho;
+    v = mod_pi(t + 0.5 * M_PI - phi);
+    return (t >= -RS_ZERO) && (u <= RS_ZERO) && (v <= RS_ZERO);
+  }
+  return false;
+}
+
+// Formula 8.11: LpRmSLmRp.
+static inline bool lp_rm_s_lm_rp(double x, double y, double phi, double sp,
+                                 double cp, double &t, double &u,
+                                 double &v) {
+  double xi = x + sp;
+  double eta = y - 1.0 - cp;
+  double rho, theta;
+  polar(xi, eta, rho, theta);
+  if (rho >= 2.0) {
+    u = 4.0 - sqrt(rho * rho - 4.0);
+    if (u <= RS_ZERO) {
+      t = mod_pi(
+          atan2((4.0 - u) * xi - 2.0 * eta, -2.0 * xi + (u - 4.0) * eta));
+      v = mod_pi(t - phi);
+      return (t >= -RS_ZERO) && (v >= -RS_ZERO);
+    }
+  }
+  return false;
+}
+
+// The shortest path found so far.
+struct ReedsSheppSolution {
+  int type;
+  double length;
+  double lengths[5];
+
+  void update(int type_in, double length_in, double l0, double l1, double l2,
+              double l3 = 0.0, double l4 = 0.0) {
+    if (length_in >= length)
+      return;
+    type = type_in;
+    length = length_in;
+    lengths[0] = l0;
+    lengths[1] = l1;
+    lengths[2] = l2;
+    lengths[3] = l3;
+    lengths[4] = l4;
+  }
+};
+
+// Every base formula is evaluated for the final state, and for the final
+// states of its time-flipped, reflected, and time-flipped and reflected
+// variants, whose paths are mapped back to the original final state.
+
+static void reeds_shepp_csc(double x, double y, double phi, double sp,
+                            double cp, ReedsSheppSolution &sol) {
+  double t, u, v;
+  if (lp_sp_lp(x, y, phi, sp, cp, t, u, v))
+    sol.update(14, fabs(t) + fabs(u) + fabs(v), t, u, v);
+  if (lp_sp_lp(-x, y, -phi, -sp, cp, t, u, v))
+    sol.update(14, fabs(t) + fabs(u) + fabs(v), -t, -u, -v);
+  if (lp_sp_lp(x, -y, -phi, -sp, cp, t, u, v))
+    sol.update(15, fabs(t) + fabs(u) + fabs(v), t, u, v);
+  if (lp_sp_lp(-x, -y, phi, sp, cp, t, u, v))
+    sol.update(15, fabs(t) + fabs(u) + fabs(v), -t, -u, -v);
+
+  if (lp_sp_rp(x, y, phi, sp, cp, t, u, v))
+    sol.update(12, fabs(t) + fabs(u) + fabs(v), t, u, v);
+  if (lp_sp_rp(-x, y, -phi, -sp, cp, t, u, v))
+    sol.update(12, fabs(t) + fabs(u) + fabs(v), -t, -u, -v);
+  if (lp_sp_rp(x, -y, -phi, -sp, cp, t, u, v))
+    sol.update(13, fabs(t) + fabs(u) + fabs(v), t, u, v);
+  if (lp_sp_rp(-x, -y, phi, sp, cp, t, u, v))
+    sol.update(13, fabs(t) + fabs(u) + fabs(v), -t, -u, -v);
+}
+
+static void reeds_shepp_ccc(double x, double y, double phi, double sp,
+                            double cp, ReedsSheppSolution &sol) {
+  double t, u, v;
+  if (lp_rm_l(x, y, phi, sp, cp, t, u, v))
+    sol.update(0, fabs(t) + fabs(u) + fabs(v), t, u, v);
+  if (lp_rm_l(-x, y, -phi, -sp, cp, t, u, v))
+    sol.update(0, fabs(t) + fabs(u) + fabs(v), -t, -u, -v);
+  if (lp_rm_l(x, -y, -phi, -sp, cp, t, u, v))
+    sol.update(1, fabs(t) + fabs(u) + fabs(v), t, u, v);
+  if (lp_rm_l(-x, -y, phi, sp, cp, t, u, v))
+    sol.update(1, fabs(t) + fabs(u) + fabs(v), -t, -u, -v);
+
+  // The paths driven backwards from the final state.
+  double xb = x * cp + y * sp;
+  double yb = x * sp - y * cp;
+  if (lp_rm_l(xb, yb, phi, sp, cp, t, u, v))
+    sol.update(0, fabs(t) + fabs(u) + fabs(v), v, u, t);
+  if (lp_rm_l(-xb, yb, -phi, -sp, cp, t, u, v))
+    sol.update(0, fabs(t) + fabs(u) + fabs(v), -v, -u, -t);
+  if (lp_rm_l(xb, -yb, -phi, -sp, cp, t, u, v))
+    sol.update(1, fabs(t) + fabs(u) + fabs(v), v, u, t);
+  if (lp_rm_l(-xb, -yb, phi, sp, cp, t, u, v))
+    sol.update(1, fabs(t) + fabs(u) + fabs(v), -v, -u, -t);
+}
+
+static void reeds_shepp_cccc(double x, double y, double phi, double sp,
+                             double cp, ReedsSheppSolution &sol) {
+  double t, u, v;
+  if (lp_rup_lum_rm(x, y, phi, sp, cp, t, u, v))
+    sol.update(2, fabs(t) + 2.0 * fabs(u) + fabs(v), t, u, -u, v);
+  if (lp_rup_lum_rm(-x, y, -phi, -sp, cp, t, u, v))
+    sol.update(2, fabs(t) + 2.0 * fabs(u) + fabs(v), -t, -u, u, -v);
+  if (lp_rup_lum_rm(x, -y, -phi, -sp, cp, t, u, v))
+    sol.update(3, fabs(t) + 2.0 * fabs(u) + fabs(v), t, u, -u, v);
+  if (lp_rup_lum_rm(-x, -y, phi, sp, cp, t, u, v))
+    sol.update(3, fabs(t) + 2.0 * fabs(u) + fabs(v), -t, -u, u, -v);
+
+  if (lp_rum_lum_rp(x, y, phi, sp, cp, t, u, v))
+    sol.update(2, fabs(t) + 2.0 * fabs(u) + fabs(v), t, u, u, v);
+  if (lp_rum_lum_rp(-x, y, -phi, -sp, cp, t, u, v))
+    sol.update(2, fabs(t) + 2.0 * fabs(u) + fabs(v), -t, -u, -u, -v);
+  if (lp_rum_lum_rp(x, -y, -phi, -sp, cp, t, u, v))
+    sol.update(3, fabs(t) + 2.0 * fabs(u) + fabs(v), t, u, u, v);
+  if (lp_rum_lum_rp(-x, -y, phi, sp, cp, t, u, v))
+    sol.update(3, fabs(t) + 2.0 * fabs(u) + fabs(v), -t, -u, -u, -v);
+}
+
+static void reeds_shepp_ccsc(double x, double y, double phi, double sp,
+                             double cp, ReedsSheppSolution &sol) {
+  const double a = 0.5 * M_PI;
+  double t, u, v;
+  if (lp_rm_sm_lm(x, y, phi, sp, cp, t, u, v))
+    sol.update(4, fabs(t) + fabs(u) + fabs(v) + a, t, -a, u, v);
+  if (lp_rm_sm_lm(-x, y, -phi, -sp, cp, t, u, v))
+    sol.update(4, fabs(t) + fabs(u) + fabs(v) + a, -t, a, -u, -v);
+  if (lp_rm_sm_lm(x, -y, -phi, -sp, cp, t, u, v))
+    sol.update(5, fabs(t) + fabs(u) + fabs(v) + a, t, -a, u, v);
+  if (lp_rm_sm_lm(-x, -y, phi, sp, cp, t, u, v))
+    sol.update(5, fabs(t) + fabs(u) + fabs(v) + a, -t, a, -u, -v);
+
+  if (lp_rm_sm_rm(x, y, phi, sp, cp, t, u, v))
+    sol.update(8, fabs(t) + fabs(u) + fabs(v) + a, t, -a, u, v);
+  if (lp_rm_sm_rm(-x, y, -phi, -sp, cp, t, u, v))
+    sol.update(8, fabs(t) + fabs(u) + fabs(v) + a, -t, a, -u, -v);
+  if (lp_rm_sm_rm(x, -y, -phi, -sp, cp, t, u, v))
+    sol.update(9, fabs(t) + fabs(u) + fabs(v) + a, t, -a, u, v);
+  if (lp_rm_sm_rm(-x, -y, phi, sp, cp, t, u, v))
+    sol.update(9, fabs(t) + fabs(u) + fabs(v) + a, -t, a, -u, -v);
+
+  // The paths driven backwards from the final state.
+  double xb = x * cp + y * sp;
+  double yb = x * sp - y * cp;
+  if (lp_rm_sm_lm(xb, yb, phi, sp, cp, t, u, v))
+    sol.update(6, fabs(t) + fabs(u) + fabs(v) + a, v, u, -a, t);
+  if (lp_rm_sm_lm(-xb, yb, -phi, -sp, cp, t, u, v))
+    sol.update(6, fabs(t) + fabs(u) + fabs(v) + a, -v, -u, a, -t);
+  if (lp_rm_sm_lm(xb, -yb, -phi, -sp, cp, t, u, v))
+    sol.update(7, fabs(t) + fabs(u) + fabs(v) + a, v, u, -a, t);
+  if (lp_rm_sm_lm(-xb, -yb, phi, sp, cp, t, u, v))
+    sol.update(7, fabs(t) + fabs(u) + fabs(v) + a, -v, -u, a, -t);
+
+  if (lp_rm_sm_rm(xb, yb, phi, sp, cp, t, u, v))
+    sol.update(10, fabs(t) + fabs(u) + fabs(v) + a, v, u, -a, t);
+  if (lp_rm_sm_rm(-xb, yb, -phi, -sp, cp, t, u, v))
+    sol.update(10, fabs(t) + fabs(u) + fabs(v) + a, -v, -u, a, -t);
+  if (lp_rm_sm_rm(xb, -yb, -phi, -sp, cp, t, u, v))
+    sol.update(11, fabs(t) + fabs(u) + fabs(v) + a, v, u, -a, t);
+  if (lp_rm_sm_rm(-xb, -yb, phi, sp, cp, t, u, v))
+    sol.update(11, fabs(t) + fabs(u) + fabs(v) + a, -v, -u, a, -t);
+}
+
+static void reeds_shepp_ccscc(double x, double y, double phi, double sp,
+                              double cp, ReedsSheppSolution &sol) {
+  const double a = 0.5 * M_PI;
+  double t, u, v;
+  if (lp_rm_s_lm_rp(x, y, phi, sp, cp, t, u, v))
+    sol.update(16, fabs(t) + fabs(u) + fabs(v) + 2.0 * a, t, -a, u, -a, v);
+  if (lp_rm_s_lm_rp(-x, y, -phi, -sp, cp, t, u, v))
+    sol.update(16, fabs(t) + fabs(u) + fabs(v) + 2.0 * a, -t, a, -u, a, -v);
+  if (lp_rm_s_lm_rp(x, -y, -phi, -sp, cp, t, u, v))
+    sol.update(17, fabs(t) + fabs(u) + fabs(v) + 2.0 * a, t, -a, u, -a, v);
+  if (lp_rm_s_lm_rp(-x, -y, phi, sp, cp, t, u, v))
+    sol.update(17, fabs(t) + fabs(u) + fabs(v) + 2.0 * a, -t, a, -u, a, -v);
+}
+
+// Finds the shortest path in the normalized frame, where the initial state
+// is the origin with heading zero, the final state is (x, y, phi) and the
+// turning radius is one. Paths that are not shorter than length_max are
+// skipped. Returns the index of the type of the path, or -1 if there is
+// none.
+static int reeds_shepp_shortest(double x, double y, double phi,
+                                double length_max, double *lengths_out) {
+
+  ReedsSheppSolution sol;
+  sol.type = -1;
+  sol.length = length_max;
+
+  // Every path is longer than the distance between its ends.
+  if (sqrt(x * x + y * y) >= length_max)
+    return -1;
+
+  double sp = sin(phi);
+  double cp = cos(phi);
+
+  reeds_shepp_csc(x, y, phi, sp, cp, sol);
+  reeds_shepp_ccc(x, y, phi, sp, cp, sol);
+  reeds_shepp_cccc(x, y, phi, sp, cp, sol);
+
+  // The families below contain fixed quarter turns.
+  if (sol.length > 0.5 * M_PI)
+    reeds_shepp_ccsc(x, y, phi, sp, cp, sol);
+  if (sol.length > M_PI)
+    reeds_shepp_ccscc(x, y, phi, sp, cp, sol);
+
+  if (sol.type >= 0)
+    for (int j = 0; j < 5; j++)
+      lengths_out[j] = sol.lengths[j];
+
+  return sol.type;
+}
+
+ReedsShepp::ReedsShepp() {}
+
+ReedsShepp::~ReedsShepp() {}
+
+int ReedsShepp::solve(StateReedsShepp *state_from_in,
+                      StateReedsShepp *state_towards_in,
+                      PathReedsShepp *path_out) {
+
+  // Reuse the last path if it connects the same states.
+  if ((path_last.type >= 0) &&
+      ((*state_from_in)[0] == state_from_last[0]) &&
+      ((*state_from_in)[1] == state_from_last[1]) &&
+      ((*state_from_in)[2] == state_from_last[2]) &&
+      ((*state_towards_in)[0] == state_towards_last[0]) &&
+      ((*state_towards_in)[1] == state_towards_last[1]) &&
+      ((*state_towards_in)[2] == state_towards_last[2])) {
+    *path_out = path_last;
+    return 1;
+  }
+
+  // Transform to the frame of the initial state, scaled by the turning
+  // radius.
+  double dx = (*state_towards_in)[0] - (*state_from_in)[0];
+  double dy = (*state_towards_in)[1] - (*state_from_in)[1];
+  double c = cos((*state_from_in)[2]);
+  double s = sin((*state_from_in)[2]);
+  double x = (c * dx + s * dy) / turning_radius;
+  double y = (-s * dx + c * dy) / turning_radius;
+  double phi = (*state_towards_in)[2] - (*state_from_in)[2];
+
+  double lengths[5];
+  path_out->type = reeds_shepp_shortest(x, y, phi, DBL_MAX, lengths);
+  path_out->turning_radius = turning_radius;
+  if (path_out->type < 0)
+    return 0;
+
+  for (int j = 0; j < 5; j++)
+    path_out->lengths[j] = lengths[j] * turning_radius;
+
+  path_last = *path_out;
+  state_from_last = *state_from_in;
+  state_towards_last = *state_towards_in;
+
+  return 1;
+}
+
+int ReedsShepp::materialize(StateReedsShepp *state_from_in,
+                            StateReedsShepp *state_towards_in,
+                            const PathReedsShepp &path_in, double step_in,
+                            int *exact_connection_out,
+                            TrajectoryReedsShepp *trajectory_out,
+                            collision_checker_t *collision_checker_in) {
+
+  if (exact_connection_out)
+    *exact_connection_out = 0;
+
+  if ((path_in.type < 0) || !(step_in > 0.0))
+    return -1;
+
+  // The state that the next step starts from.
+  StateReedsShepp *state_prev = state_from_in;
+
+  double radius = path_in.turning_radius;
+
+  double x = (*state_from_in)[0];
+  double y = (*state_from_in)[1];
+  double t = (*state_from_in)[2];
+
+  double distance_travel = 0.0;
+
+  for (int j = 0; j < 5; j++) {
+
+    int turn = reeds_shepp_types[path_in.type][j];
+    if (turn == 2)
+      break;
+
+    double direction = (path_in.lengths[j] < 0.0) ? -1.0 : 1.0;
+    double length_segment = fabs(path_in.lengths[j]);
+
+    // Generate the states of the segment from its initial pose, so that
+    // the errors do not accumulate along the segment.
+    double d_inc_curr = 0.0;
+    while (d_inc_curr < length_segment) {
+      double d_inc_rel = step_in;
+      d_inc_curr += step_in;
+      if (d_inc_curr > length_segment) {
+        d_inc_rel -= d_inc_curr - length_segment;
+        d_inc_curr = length_segment;
+      }
+
+      StateReedsShepp *state_curr = new StateReedsShepp;
+      InputReedsShepp *input_curr = new InputReedsShepp;
+
+      double d_signed = direction * d_inc_curr;
+      if (turn == 0) {
+        (*state_curr)[0] = x + d_signed * cos(t);
+        (*state_curr)[1] = y + d_signed * sin(t);
+        (*state_curr)[2] = t;
+      } else {
+        double t_curr = t + turn * d_signed / radius;
+        (*state_curr)[0] = x + turn * radius * (sin(t_curr) - sin(t));
+        (*state_curr)[1] = y - turn * radius * (cos(t_curr) - cos(t));
+        (*state_curr)[2] = t_curr;
+      }
+      (*state_curr)[2] = mod_2pi((*state_curr)[2]);
+
+      (*input_curr)[0] = d_inc_rel;
+      (*input_curr)[1] = -turn;
+      (*input_curr)[2] = direction;
+
+      if (collision_checker_in &&
+          (collision_checker_in->check_collision_step(state_prev,
+                                                      state_curr) != 1)) {
+        delete state_curr;
+        delete input_curr;
+        return 0;
+      }
+      state_prev = state_curr;
+
+      trajectory_out->list_states.push_back(state_curr);
+      trajectory_out->list_inputs.push_back(input_curr);
+
+      if (distance_travel + d_inc_curr > DISTANCE_LIMIT)
+        return 1;
+    }
+
+    distance_travel += length_segment;
+
+    // Move to the final pose of the segment.
+    double d_signed = path_in.lengths[j];
+    if (turn == 0) {
+      x += d_signed * cos(t);
+      y += d_signed * sin(t);
+    } else {
+      double t_next = t + turn * d_signed / radius;
+      x += turn * radius * (sin(t_next) - sin(t));
+      y -= turn * radius * (cos(t_next) - cos(t));
+      t = t_next;
+    }
+  }
+
+  // The last state is the final state, up to the rounding errors.
+  if (!trajectory_out->list_states.empty()) {
+    StateReedsShepp *state_last = trajectory_out->list_states.back();
+    (*state_last)[0] = (*state_towards_in)[0];
+    (*state_last)[1] = (*state_towards_in)[1];
+    (*state_last)[2] = mod_2pi((*state_towards_in)[2]);
+  }
+
+  if (exact_connection_out)
+    *exact_connection_out = 1;
+
+  return 1;
+}
+
+int ReedsShepp::lengths_from(StateReedsShepp *state_from_in, int num_states,
+                             const double *x_in, const double *y_in,
+                             const double *t_in, const double *lengths_max_in,
+                             double *lengths_out) {
+
+  // The rotation to the frame of the shared state is computed once.
+  double x0 = (*state_from_in)[0];
+  double y0 = (*state_from_in)[1];
+  double t0 = (*state_from_in)[2];
+  double c = cos(t0) / turning_radius;
+  double s = sin(t0) / turning_radius;
+
+  double lengths[5];
+
+  for (int i = 0; i < num_states; i++) {
+    double dx = x_in[i] - x0;
+    double dy = y_in[i] - y0;
+    double length_max =
+        lengths_max_in ? lengths_max_in[i] / turning_radius : DBL_MAX;
+
+    if (reeds_shepp_shortest(c * dx + s * dy, -s * dx + c * dy, t_in[i] - t0,
+                             length_max, lengths) < 0) {
+      lengths_out[i] = length_max * turning_radius;
+      continue;
+    }
+
+    double length = 0.0;
+    for (int j = 0; j < 5; j++)
+      length += fabs(lengths[j]);
+    lengths_out[i] = length * turning_radius;
+  }
+
+  return 1;
+}
+
+void ReedsShepp::gather_batch(StateReedsShepp **states_in, int num_states) {
+
+  batch_x.resize(num_states);
+  batch_y.resize(num_states);
+  batch_t.resize(num_states);
+  for (int i = 0; i < num_states; i++) {
+    batch_x[i] = (*states_in[i])[0];
+    batch_y[i] = (*states_in[i])[1];
+    batch_t[i] = (*states_in[i])[2];
+  }
+}
+
+int ReedsShepp::extend(
+    StateReedsShepp *state_from_in, StateReedsShepp *state_towards_in,
+    int *exact_connection_out, TrajectoryReedsShepp *trajectory_out,
+    std::list<StateReedsShepp *> *intermediate_vertices_out) {
+
+  if (exact_connection_out)
+    *exact_connection_out = 0;
+  if (intermediate_vertices_out)
+    intermediate_vertices_out->clear();
+
+  PathReedsShepp path;
+  if (solve(state_from_in, state_towards_in, &path) <= 0)
+    return 0;
+
+  if (materialize(state_from_in, state_towards_in, path, step,
+                  exact_connection_out, trajectory_out) <= 0)
+    return 0;
+
+  // The states coincide, there is no trajectory to add.
+  if (trajectory_out->list_states.empty())
+    return 0;
+
+  return 1;
+}
+
+int ReedsShepp::extend_checked(
+    StateReedsShepp *state_from_in, StateReedsShepp *state_towards_in,
+    collision_checker_t &collision_checker, int *exact_connection_out,
+    TrajectoryReedsShepp *trajectory_out,
+    std::list<StateReedsShepp *> *intermediate_vertices_out) {
+
+  if (exact_connection_out)
+    *exact_connection_out = 0;
+  if (intermediate_vertices_out)
+    intermediate_vertices_out->clear();
+
+  PathReedsShepp path;
+  if (solve(state_from_in, state_towards_in, &path) <= 0)
+    return -1;
+
+  int result = materialize(state_from_in, state_towards_in, path, step,
+                           exact_connection_out, trajectory_out,
+                           &collision_checker);
+  if (result < 0)
+    return result;
+
+  // The states coincide, there is no trajectory to add.
+  if ((result == 1) && trajectory_out->list_states.empty())
+    return -1;
+
+  return result;
+}
+
+double ReedsShepp::cost_lower_bound(StateReedsShepp *state_from_in,
+                                    StateReedsShepp *state_towards_in) {
+
+  double dx = (*state_towards_in)[0] - (*state_from_in)[0];
+  double dy = (*state_towards_in)[1] - (*state_from_in)[1];
+
+  return sqrt(dx * dx + dy * dy);
+}
+
+double ReedsShepp::cost_extend_lower_bound(StateReedsShepp *state_from_in,
+                                           StateReedsShepp *state_towards_in) {
+
+  PathReedsShepp path;
+  if (solve(state_from_in, state_towards_in, &path) <= 0)
+    return cost_lower_bound(state_from_in, state_towards_in);
+
+  return path.get_length();
+}
+
+int ReedsShepp::cost_extend_lower_bounds_from(
+    StateReedsShepp *state_from_in, StateReedsShepp **states_towards_in,
+    int num_states, const double *costs_max_in, double *bounds_out) {
+
+  gather_batch(states_towards_in, num_states);
+  return lengths_from(state_from_in, num_states, batch_x.data(),
+                      batch_y.data(), batch_t.data(), costs_max_in,
+                      bounds_out);
+}
+
+int ReedsShepp::cost_extend_lower_bounds_to(
+    StateReedsShepp **states_from_in, StateReedsShepp *state_towards_in,
+    int num_states, const double *costs_max_in, double *bounds_out) {
+
+  // The length of the shortest path is symmetric.
+  gather_batch(states_from_in, num_states);
+  return lengths_from(state_towards_in, num_states, batch_x.data(),
+                      batch_y.data(), batch_t.data(), costs_max_in,
+                      bounds_out);
+}
+
+} // namespace extenders
+} // namespace smp
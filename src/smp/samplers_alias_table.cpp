@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <smp/samplers/alias_table.hpp>
+
+#include <iostream>
+
+namespace smp {
+namespace samplers {
+
+AliasTable::AliasTable() {}
+
+AliasTable::~AliasTable() {}
+
+int AliasTable::build(const double *weights, int num_weights) {
+
+  double total = 0.0;
+  for (int i = 0; i < num_weights; i++)
+    total += weights[i];
+
+  if ((num_weights <= 0) || !(total > 0.0)) {
+    std::cerr << "[build]: WEIGHTS DO NOT SUM TO A POSITIVE NUMBER!\n";
+    probability.clear();
+    alias.clear();
+    return 0;
+  }
+
+  probability.resize(num_weights);
+  alias.resize(num_weights);
+  scaled.resize(num_weights);
+  small.clear();
+  large.clear();
+
+  // Scale the weights so that their mean is one, and split the entries into
+  // those below and above the mean.
+  for (int i = 0; i < num_weights; i++) {
+    scaled[i] = weights[i] * num_weights / total;
+    if (scaled[i] < 1.0)
+      small.push_back(i);
+    else
+      large.push_back(i);
+  }
+
+  // Fill every small entry up to one with the excess of a large entry.
+  while (!small.empty() && !large.empty()) {
+    int entry_small = small.back();
+    small.pop_back();
+    int entry_large = large.back();
+
+    probability[entry_small] = scaled[entry_small];
+    alias[entry_small] = entry_large;
+
+    scaled[entry_large] -= 1.0 - scaled[entry_small];
+    if (scaled[entry_large] < 1.0) {
+      large.pop_back();
+      small.push_back(entry_large);
+    }
+  }
+
+  // The remaining entries are full, up to rounding errors.
+  for (int entry : large) {
+    probability[entry] = 1.0;
+    alias[entry] = entry;
+  }
+  for (int entry : small) {
+    probability[entry] = 1.0;
+    alias[entry] = entry;
+  }
+
+  return 1;
+}
+
+void AliasTable::build_uniform(int num_entries) {
+
+  probability.assign(num_entries, 1.0);
+  alias.resize(num_entries);
+  for (int i = 0; i < num_entries; i++)
+    alias[i] = i;
+}
+} // namespace samplers
+} // namespace smp
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <smp/samplers/halton_sequence.hpp>
+#include <smp/samplers/random.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Largest size of a block of a radical inverse table.
+#define HALTON_MAX_BLOCK_SIZE 2048
+
+// Number of index bits covered by the tables. Larger indices fall back to a
+// loop over the remaining digits.
+#define HALTON_TABLE_BITS 32
+
+namespace smp {
+namespace samplers {
+
+namespace {
+
+bool is_prime(int n) {
+  if (n < 2)
+    return false;
+  for (int d = 2; d * d <= n; d++)
+    if (n % d == 0)
+      return false;
+  return true;
+}
+} // namespace
+
+HaltonSequence::HaltonSequence()
+    : num_dimensions(0), scrambled(false), scrambling_seed(0), index(1),
+      stride(1) {}
+
+HaltonSequence::~HaltonSequence() {}
+
+int HaltonSequence::set_dimensions(int num_dimensions_in) {
+
+  if (num_dimensions_in <= 0) {
+    std::cerr << "[set_dimensions]: NUMBER OF DIMENSIONS MUST BE POSITIVE!\n";
+    return 0;
+  }
+
+  num_dimensions = num_dimensions_in;
+
+  bases.clear();
+  for (int n = 2; (int)bases.size() < num_dimensions; n++)
+    if (is_prime(n))
+      bases.push_back(n);
+
+  build_tables();
+
+  return 1;
+}
+
+int HaltonSequence::set_scrambling(bool scrambled_in, uint64_t seed) {
+
+  scrambled = scrambled_in;
+  scrambling_seed = seed;
+
+  if (num_dimensions > 0)
+    build_tables();
+
+  return 1;
+}
+
+int HaltonSequence::set_stream(int worker, int num_workers) {
+
+  if ((num_workers <= 0) || (worker < 0) || (worker >= num_workers)) {
+    std::cerr << "[set_stream]: INVALID WORKER INDEX!\n";
+    return 0;
+  }
+
+  // The stride must not share a factor with any base, or the coordinates of
+  // that base would only take a fraction of their values along the stream.
+  stride = 1;
+  if (num_workers > 1) {
+    int stride_prime = num_workers;
+    while (!is_prime(stride_prime) ||
+           (std::find(bases.begin(), bases.end(), stride_prime) !=
+            bases.end()))
+      stride_prime++;
+    stride = (uint64_t)stride_prime;
+  }
+
+  // The unscrambled sequence starts at 1, since its first point is the
+  // corner of the unit cube.
+  index = (scrambled ? 0 : 1) + (uint64_t)worker;
+
+  return 1;
+}
+
+void HaltonSequence::build_tables() {
+
+  block_digits.resize(num_dimensions);
+  block_sizes.resize(num_dimensions);
+  num_blocks.resize(num_dimensions);
+  num_digits.resize(num_dimensions);
+  permutations.resize(num_dimensions);
+  tables.resize(num_dimensions);
+  tails.resize(num_dimensions);
+
+  Xoshiro256PlusPlus generator;
+  generator.seed(scrambling_seed);
+
+  for (int d = 0; d < num_dimensions; d++) {
+    int base = bases[d];
+    double bits_per_digit = log2((double)base);
+
+    block_digits[d] = 1;
+    block_sizes[d] = (uint64_t)base;
+    while (block_sizes[d] * base <= HALTON_MAX_BLOCK_SIZE) {
+      block_digits[d]++;
+      block_sizes[d] *= base;
+    }
+    num_blocks[d] = (int)ceil(HALTON_TABLE_BITS /
+                              (block_digits[d] * bits_per_digit));
+
+    // Enough digits to tell apart all 64-bit indices, and to reach the
+    // precision of a double.
+    num_digits[d] = std::max((int)ceil(64.0 / bits_per_digit),
+                             (int)ceil(53.0 / bits_per_digit)) +
+                    1;
+    num_digits[d] = std::max(num_digits[d], num_blocks[d] * block_digits[d]);
+
+    permutations[d].resize(num_digits[d]);
+    for (int j = 0; j < num_digits[d]; j++) {
+      std::vector<int> &permutation = permutations[d][j];
+      permutation.resize(base);
+      for (int digit = 0; digit < base; digit++)
+        permutation[digit] = digit;
+      if (scrambled) {
+        for (int digit = base - 1; digit > 0; digit--) {
+          int other = (int)(generator.next() % (uint64_t)(digit + 1));
+          std::swap(permutation[digit], permutation[other]);
+        }
+      }
+    }
+
+    // Every entry of a block holds the contribution of its digits at the
+    // digit positions of that block.
+    tables[d].resize(num_blocks[d] * block_sizes[d]);
+    for (int c = 0; c < num_blocks[d]; c++) {
+      double scale_block = pow((double)base, -(double)(c * block_digits[d]));
+      for (uint64_t m = 0; m < block_sizes[d]; m++) {
+        double value = 0.0;
+        double scale = scale_block / base;
+        uint64_t digits = m;
+        for (int i = 0; i < block_digits[d]; i++) {
+          value += permutations[d][c * block_digits[d] + i][digits % base] *
+                   scale;
+          digits /= base;
+          scale /= base;
+        }
+        tables[d][c * block_sizes[d] + m] = value;
+      }
+    }
+
+    // Digit positions beyond the tables hold zero digits.
+    tails[d] = 0.0;
+    double scale =
+        pow((double)base, -(double)(num_blocks[d] * block_digits[d] + 1));
+    for (int j = num_blocks[d] * block_digits[d]; j < num_digits[d]; j++) {
+      tails[d] += permutations[d][j][0] * scale;
+      scale /= base;
+    }
+  }
+
+  index = scrambled ? 0 : 1;
+  stride = 1;
+}
+
+double HaltonSequence::radical_inverse(int dimension, uint64_t n) const {
+
+  const double *table = tables[dimension].data();
+  uint64_t block_size = block_sizes[dimension];
+
+  double value = 0.0;
+  for (int c = 0; c < num_blocks[dimension]; c++) {
+    value += table[c * block_size + n % block_size];
+    n /= block_size;
+  }
+
+  if (n == 0) {
+    value += tails[dimension];
+  } else {
+    int base = bases[dimension];
+    int first_digit = num_blocks[dimension] * block_digits[dimension];
+    double scale = pow((double)base, -(double)(first_digit + 1));
+    for (int j = first_digit; j < num_digits[dimension]; j++) {
+      value += permutations[dimension][j][n % base] * scale;
+      n /= base;
+      scale /= base;
+    }
+  }
+
+  // Rounding may push the sum of the digits of a scrambled sequence to 1.
+  return std::min(value, std::nextafter(1.0, 0.0));
+}
+
+void HaltonSequence::next(double *point_out) {
+
+  for (int d = 0; d < num_dimensions; d++)
+    point_out[d] = radical_inverse(d, index);
+
+  index += stride;
+}
+} // namespace samplers
+} // namespace smp
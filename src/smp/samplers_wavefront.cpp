@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2018 Chittaranjan Srinivas Swaminathan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <smp/samplers/wavefront.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+
+// Largest ratio between the octile and the Euclidean length of a segment.
+#define WAVEFRONT_OCTILE_RATIO 1.0823922002923940
+
+namespace smp {
+namespace samplers {
+
+Wavefront::Wavefront()
+    : size_x(0), size_y(0), resolution(0.05), origin_x(0.0), origin_y(0.0) {}
+
+Wavefront::~Wavefront() {}
+
+int Wavefront::compute(const unsigned char *free_mask, int size_x_in,
+                       int size_y_in, double resolution_in, double origin_x_in,
+                       double origin_y_in, double x_min, double y_min,
+                       double x_max, double y_max) {
+
+  size_x = size_x_in;
+  size_y = size_y_in;
+  resolution = resolution_in;
+  origin_x = origin_x_in;
+  origin_y = origin_y_in;
+
+  const double infinity = std::numeric_limits<double>::infinity();
+  distances.assign(size_x * size_y, infinity);
+  heap.clear();
+
+  std::greater<std::pair<double, int>> heap_order;
+
+  // 1. Seed the free cells whose center is in the source box, and the cell
+  // that contains the center of the box.
+  int cell_x_min =
+      std::max(0, (int)ceil((x_min - origin_x) / resolution - 0.5));
+  int cell_y_min =
+      std::max(0, (int)ceil((y_min - origin_y) / resolution - 0.5));
+  int cell_x_max =
+      std::min(size_x - 1, (int)floor((x_max - origin_x) / resolution - 0.5));
+  int cell_y_max =
+      std::min(size_y - 1, (int)floor((y_max - origin_y) / resolution - 0.5));
+
+  for (int cell_y = cell_y_min; cell_y <= cell_y_max; cell_y++) {
+    for (int cell_x = cell_x_min; cell_x <= cell_x_max; cell_x++) {
+      int index = cell_y * size_x + cell_x;
+      if (free_mask[index]) {
+        distances[index] = 0.0;
+        heap.push_back(std::make_pair(0.0, index));
+      }
+    }
+  }
+
+  int cell_x = (int)floor(((x_min + x_max) / 2.0 - origin_x) / resolution);
+  int cell_y = (int)floor(((y_min + y_max) / 2.0 - origin_y) / resolution);
+  if ((cell_x >= 0) && (cell_y >= 0) && (cell_x < size_x) &&
+      (cell_y < size_y)) {
+    int index = cell_y * size_x + cell_x;
+    if (free_mask[index] && (distances[index] > 0.0)) {
+      distances[index] = 0.0;
+      heap.push_back(std::make_pair(0.0, index));
+    }
+  }
+
+  if (heap.empty()) {
+    std::cerr << "[compute]: NO FREE SOURCE CELL!\n";
+    return 0;
+  }
+
+  // 2. Expand the wavefront. Entries whose distance has been improved since
+  // they were pushed are skipped when they are popped.
+  const int offsets_x[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+  const int offsets_y[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+  const double steps[8] = {resolution,           resolution,
+                           resolution,           resolution,
+                           M_SQRT2 * resolution, M_SQRT2 * resolution,
+                           M_SQRT2 * resolution, M_SQRT2 * resolution};
+
+  int num_reached = 0;
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), heap_order);
+    double distance = heap.back().first;
+    int index = heap.back().second;
+    heap.pop_back();
+
+    if (distance > distances[index])
+      continue;
+    num_reached++;
+
+    int x = index % size_x;
+    int y = index / size_x;
+    for (int k = 0; k < 8; k++) {
+      int x_next = x + offsets_x[k];
+      int y_next = y + offsets_y[k];
+      if ((x_next < 0) || (y_next < 0) || (x_next >= size_x) ||
+          (y_next >= size_y))
+        continue;
+
+      int index_next = y_next * size_x + x_next;
+      double distance_next = distance + steps[k];
+      if (!free_mask[index_next] || (distance_next >= distances[index_next]))
+        continue;
+
+      distances[index_next] = distance_next;
+      heap.push_back(std::make_pair(distance_next, index_next));
+      std::push_heap(heap.begin(), heap.end(), heap_order);
+    }
+  }
+
+  return num_reached;
+}
+
+double Wavefront::get_distance(double x, double y) const {
+
+  int cell_x = (int)floor((x - origin_x) / resolution);
+  int cell_y = (int)floor((y - origin_y) / resolution);
+  if ((cell_x < 0) || (cell_y < 0) || (cell_x >= size_x) ||
+      (cell_y >= size_y))
+    return std::numeric_limits<double>::infinity();
+
+  return distances[cell_y * size_x + cell_x];
+}
+
+double Wavefront::get_lower_bound(double x, double y) const {
+
+  double distance = get_distance(x, y);
+  if (std::isinf(distance))
+    return distance;
+
+  // Both ends of the path may be anywhere in their cells.
+  return std::max(0.0, distance / WAVEFRONT_OCTILE_RATIO -
+                           2.0 * M_SQRT2 * resolution);
+}
+
+int Wavefront::corridor_weights(const Wavefront &field_first,
+                                const Wavefront &field_second, double width,
+                                double weight_floor,
+                                std::vector<double> &weights_out) {
+
+  if (!(width > 0.0) || (weight_floor < 0.0)) {
+    std::cerr << "[corridor_weights]: INVALID WIDTH OR FLOOR!\n";
+    return 0;
+  }
+
+  int num_cells = field_first.size_x * field_first.size_y;
+  if ((field_second.size_x != field_first.size_x) ||
+      (field_second.size_y != field_first.size_y)) {
+    std::cerr << "[corridor_weights]: FIELDS HAVE DIFFERENT SIZES!\n";
+    return 0;
+  }
+
+  double distance_shortest = std::numeric_limits<double>::infinity();
+  for (int index = 0; index < num_cells; index++)
+    distance_shortest =
+        std::min(distance_shortest, field_first.distances[index] +
+                                        field_second.distances[index]);
+
+  if (std::isinf(distance_shortest)) {
+    std::cerr << "[corridor_weights]: SOURCES ARE NOT CONNECTED!\n";
+    return 0;
+  }
+
+  weights_out.resize(num_cells);
+  for (int index = 0; index < num_cells; index++) {
+    double excess = field_first.distances[index] +
+                    field_second.distances[index] - distance_shortest;
+    // The exponential of an infinite excess is zero.
+    weights_out[index] = weight_floor + exp(-excess / width);
+  }
+
+  return 1;
+}
+} // namespace samplers
+} // namespace smp
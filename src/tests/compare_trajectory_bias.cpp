@@ -0,0 +1,133 @@
+// Compares the best costs that RRT* reaches with uniform samples and with
+// samples biased around the best trajectory, as the planners configure the
+// trajectory bias sampler. Prints the mean best cost over several seeds
+// after each number of iterations.
+
+#include <functional>
+
+#include <smp/collision_checkers/standard.hpp>
+#include <smp/distance_evaluators/kdtree.hpp>
+#include <smp/extenders/dubins.hpp>
+#include <smp/multipurpose/minimum_time_reachability.hpp>
+#include <smp/planners/rrtstar.hpp>
+#include <smp/samplers/trajectory_bias.hpp>
+#include <smp/samplers/uniform.hpp>
+
+#include <cmath>
+#include <cstdio>
+
+typedef smp::StateDubins State;
+typedef smp::InputDubins Input;
+typedef smp::Trajectory<State, Input> trajectory_t;
+
+const int NUM_SEEDS = 5;
+const int NUM_CHECKPOINTS = 4;
+const int CHECKPOINTS[NUM_CHECKPOINTS] = {500, 1000, 2000, 4000};
+
+// Runs the planner with the given bias probability, and stores the best
+// cost after each checkpoint, or -1 if no trajectory reaches the goal.
+void run(double bias_probability, uint64_t seed, double *costs_out) {
+
+  smp::Region<3> region_operating;
+  region_operating.size[0] = 10.0;
+  region_operating.size[1] = 10.0;
+  region_operating.size[2] = 2.0 * M_PI;
+
+  smp::samplers::Uniform<State, 3> sampler_uniform;
+  sampler_uniform.set_support(region_operating);
+  sampler_uniform.set_seed(seed);
+
+  smp::samplers::TrajectoryBias<State, Input, 3> sampler(sampler_uniform);
+  sampler.set_seed(seed);
+  sampler.set_bias_probability(bias_probability);
+  sampler.set_sample_dispersion(0.5);
+  sampler.set_angular_dispersion(2, 0.5);
+
+  smp::distance_evaluators::KDTree<State, Input, 3> distance_evaluator;
+  smp::extenders::Dubins extender;
+  extender.set_step(0.25);
+
+  // Two walls with a gap each, so that the best trajectory has to weave
+  // between them.
+  smp::collision_checkers::Standard<State, Input, 2> collision_checker;
+  smp::Region<2> obstacle;
+  obstacle.center[0] = -1.5;
+  obstacle.center[1] = 1.0;
+  obstacle.size[0] = 0.5;
+  obstacle.size[1] = 8.0;
+  collision_checker.add_obstacle(obstacle);
+  obstacle.center[0] = 1.5;
+  obstacle.center[1] = -1.0;
+  collision_checker.add_obstacle(obstacle);
+
+  smp::multipurpose::MinimumTimeReachability<State, Input, 3>
+      min_time_reachability;
+  smp::Region<3> region_goal;
+  region_goal.center[0] = 3.5;
+  region_goal.center[1] = 3.5;
+  region_goal.size[0] = 0.5;
+  region_goal.size[1] = 0.5;
+  region_goal.size[2] = 10.0;
+  min_time_reachability.set_goal_region(region_goal);
+  if (bias_probability > 0.0) {
+    min_time_reachability.register_new_update_function(
+        [&sampler](trajectory_t *trajectory) {
+          return sampler.update_trajectory(trajectory);
+        });
+  }
+
+  smp::planners::RRTStar<State, Input> planner(
+      sampler, distance_evaluator, extender, collision_checker,
+      min_time_reachability, min_time_reachability);
+  planner.parameters.set_phase(2);
+  planner.parameters.set_gamma(10.0);
+  planner.parameters.set_dimension(3);
+  planner.parameters.set_max_radius(10.0);
+  distance_evaluator.set_list_vertices(&(planner.list_vertices));
+
+  State *state_initial = new State;
+  (*state_initial)[0] = -3.5;
+  (*state_initial)[1] = -3.5;
+  (*state_initial)[2] = 0.0;
+  planner.initialize(state_initial);
+
+  int num_iterations = 0;
+  for (int i = 0; i < NUM_CHECKPOINTS; i++) {
+    for (; num_iterations < CHECKPOINTS[i]; num_iterations++)
+      planner.iteration();
+    costs_out[i] = min_time_reachability.get_best_cost();
+  }
+}
+
+int main() {
+
+  const int NUM_PROBABILITIES = 2;
+  const double probabilities[NUM_PROBABILITIES] = {0.0, 0.5};
+
+  for (int p = 0; p < NUM_PROBABILITIES; p++) {
+    double sum_costs[NUM_CHECKPOINTS] = {0.0};
+    int num_solved[NUM_CHECKPOINTS] = {0};
+    for (int seed = 1; seed <= NUM_SEEDS; seed++) {
+      double costs[NUM_CHECKPOINTS];
+      run(probabilities[p], seed, costs);
+      for (int i = 0; i < NUM_CHECKPOINTS; i++) {
+        if (costs[i] < 0.0)
+          continue;
+        sum_costs[i] += costs[i];
+        num_solved[i]++;
+      }
+    }
+
+    printf("bias probability %.1f:", probabilities[p]);
+    for (int i = 0; i < NUM_CHECKPOINTS; i++) {
+      if (num_solved[i] > 0)
+        printf("  %d it: %.2f (%d/%d)", CHECKPOINTS[i],
+               sum_costs[i] / num_solved[i], num_solved[i], NUM_SEEDS);
+      else
+        printf("  %d it: - (0/%d)", CHECKPOINTS[i], NUM_SEEDS);
+    }
+    printf("\n");
+  }
+
+  return 0;
+}
@@ -1,8 +1,63 @@
+#include <smp/collision_checkers/multiple_circles_costmap.hpp>
 #include <smp/collision_checkers/multiple_circles_mrpt.hpp>
 #include <smp/collision_checkers/standard.hpp>
 
 #include <smp/extenders/dubins.hpp>
 
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Changes cells scattered over the map, and compares the checks of a
+// checker synchronized incrementally with those of a checker that computes
+// its heading bitmaps from scratch.
+static int test_heading_bitmaps_sync() {
+  const int size_x = 150, size_y = 100;
+  std::vector<unsigned char> costs(size_x * size_y, 0);
+  for (int y = 40; y < 60; y++)
+    costs[y * size_x + 64] = 254;
+
+  std::vector<std::array<double, 2>> footprint = {
+      {0.2, 0.1}, {0.2, -0.1}, {-0.2, -0.1}, {-0.2, 0.1}};
+  smp::collision_checkers::MultipleCirclesCostmap<smp::StateDubins> checker;
+  checker.set_robot_footprint(footprint);
+  checker.set_inflation_radius(0.1);
+  checker.set_num_headings(8);
+  checker.set_map(costs.data(), size_x, size_y, 0.05, 0.0, 0.0);
+  checker.sync();
+
+  // Two far corners and the wall in the middle change.
+  costs[2 * size_x + 3] = 254;
+  costs[(size_y - 3) * size_x + size_x - 2] = 254;
+  costs[50 * size_x + 64] = 0;
+  if (checker.sync() != 3)
+    return 1;
+
+  smp::collision_checkers::MultipleCirclesCostmap<smp::StateDubins>
+      checker_fresh;
+  checker_fresh.set_robot_footprint(footprint);
+  checker_fresh.set_inflation_radius(0.1);
+  checker_fresh.set_num_headings(8);
+  checker_fresh.set_map(costs.data(), size_x, size_y, 0.05, 0.0, 0.0);
+  checker_fresh.sync();
+
+  for (int y = 0; y < size_y; y++) {
+    for (int x = 0; x < size_x; x++) {
+      for (int m = 0; m < 8; m++) {
+        smp::StateDubins state;
+        state[0] = (x + 0.5) * 0.05;
+        state[1] = (y + 0.5) * 0.05;
+        state[2] = m * 2.0 * M_PI / 8;
+        if (checker.check_collision(&state) !=
+            checker_fresh.check_collision(&state))
+          return 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
 int main() {
   smp::collision_checkers::MultipleCirclesMRPT<smp::StateDubins,
                                                smp::InputDubins>
@@ -10,5 +65,5 @@ int main() {
   smp::collision_checkers::Standard<smp::StateDubins, smp::InputDubins, 3>
       collision_checker_standard_dubins;
 
-  return 0;
+  return test_heading_bitmaps_sync();
 }
@@ -0,0 +1,89 @@
+#include <smp/extenders/double_integrator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+// Extends random pairs of states, and integrates the inputs of every
+// trajectory from its initial state. The integrated state must reach the
+// final state, and the inputs must respect the bounds. extend_time() must
+// fail exactly when extend() fails, which may happen for at most
+// max_failures pairs.
+template <int NUM_DIMENSIONS>
+int test_endpoints(int num_pairs, int max_failures) {
+
+  using state_t = smp::StateDoubleIntegrator<NUM_DIMENSIONS>;
+  using input_t = smp::InputDoubleIntegrator<NUM_DIMENSIONS>;
+
+  smp::extenders::DoubleIntegrator<NUM_DIMENSIONS> extender;
+
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-5.0, 5.0);
+  std::uniform_real_distribution<double> velocity(-1.0, 1.0);
+
+  int num_errors = 0;
+  int num_failures = 0;
+  for (int i = 0; i < num_pairs; i++) {
+    state_t state_from, state_towards;
+    for (int axis = 0; axis < NUM_DIMENSIONS; axis++) {
+      state_from[axis] = position(generator);
+      state_towards[axis] = position(generator);
+      state_from[axis + NUM_DIMENSIONS] = velocity(generator);
+      state_towards[axis + NUM_DIMENSIONS] = velocity(generator);
+    }
+
+    int exact;
+    smp::Trajectory<state_t, input_t> trajectory;
+    std::list<state_t *> intermediate_vertices;
+
+    // The arrival time of the slowest axis may be infeasible for another.
+    double time = extender.extend_time(&state_from, &state_towards);
+    if (extender.extend(&state_from, &state_towards, &exact, &trajectory,
+                        &intermediate_vertices) != 1) {
+      num_failures++;
+      if (time >= 0.0) {
+        printf("%d axes: extend_time %g for a failed extension\n",
+               NUM_DIMENSIONS, time);
+        num_errors++;
+      }
+      continue;
+    }
+
+    state_t state = state_from;
+    double duration = 0.0;
+    for (auto input : trajectory.list_inputs) {
+      double dt = (*input)[0];
+      duration += dt;
+      for (int axis = 0; axis < NUM_DIMENSIONS; axis++) {
+        double u = (*input)[1 + axis];
+        if (fabs(u) > 1.0 + 1e-6)
+          num_errors++;
+        state[axis] += state[axis + NUM_DIMENSIONS] * dt + u * dt * dt / 2.0;
+        state[axis + NUM_DIMENSIONS] += u * dt;
+      }
+    }
+
+    double error = fabs(duration - time);
+    for (int j = 0; j < 2 * NUM_DIMENSIONS; j++)
+      error = std::max(error, fabs(state[j] - state_towards[j]));
+    if (error > 1e-6) {
+      printf("%d axes: endpoint error %g\n", NUM_DIMENSIONS, error);
+      num_errors++;
+    }
+  }
+
+  if (num_failures > max_failures) {
+    printf("%d axes: %d of %d extensions failed\n", NUM_DIMENSIONS,
+           num_failures, num_pairs);
+    num_errors++;
+  }
+
+  return num_errors;
+}
+
+int main() {
+  int num_errors =
+      test_endpoints<2>(20000, 200) + test_endpoints<3>(20000, 200);
+  return (num_errors == 0) ? 0 : 1;
+}
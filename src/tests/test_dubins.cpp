@@ -0,0 +1,89 @@
+#include <smp/extenders/dubins.hpp>
+
+#include <cmath>
+#include <cstdlib>
+
+static double random_in(double min, double max) {
+  return min + (max - min) * rand() / (double)RAND_MAX;
+}
+
+int main() {
+  smp::extenders::Dubins extender;
+
+  // The path between coincident states has zero length, and the extension
+  // adds no trajectory, whatever the heading.
+  for (int i = 0; i < 64; i++) {
+    smp::StateDubins state;
+    state[0] = 1.0;
+    state[1] = 2.0;
+    state[2] = i * 2.0 * M_PI / 64;
+    smp::StateDubins state_same = state;
+
+    smp::PathDubins path;
+    if ((extender.solve(&state, &state_same, &path) != 1) ||
+        (path.get_length() != 0.0))
+      return 1;
+
+    double bound;
+    if ((extender.lengths_from(&state, 1, &state_same[0], &state_same[1],
+                               &state_same[2], NULL, &bound) != 1) ||
+        (bound != 0.0))
+      return 1;
+
+    int exact;
+    smp::Trajectory<smp::StateDubins, smp::InputDubins> trajectory;
+    std::list<smp::StateDubins *> intermediate_vertices;
+    if ((extender.extend(&state, &state_same, &exact, &trajectory,
+                         &intermediate_vertices) != 0) ||
+        !trajectory.list_states.empty())
+      return 1;
+
+    // Turning around on the spot takes a path of nonzero length.
+    smp::StateDubins state_turned = state;
+    state_turned[2] += M_PI;
+    if (!(extender.cost_extend_lower_bound(&state, &state_turned) > 0.0))
+      return 1;
+  }
+
+  // Between random states, the path ends at the goal state, and the bound
+  // that lengths_from() returns for the paths it skips is not longer than
+  // the path.
+  srand(1);
+  for (int k = 0; k < 1000; k++) {
+    smp::StateDubins state_from, state_towards;
+    for (int i = 0; i < 2; i++) {
+      state_from[i] = random_in(-5.0, 5.0);
+      state_towards[i] = random_in(-5.0, 5.0);
+    }
+    state_from[2] = random_in(-M_PI, M_PI);
+    state_towards[2] = random_in(-M_PI, M_PI);
+
+    smp::PathDubins path;
+    if (extender.solve(&state_from, &state_towards, &path) != 1)
+      return 1;
+
+    int exact = -1;
+    smp::Trajectory<smp::StateDubins, smp::InputDubins> trajectory;
+    if ((extender.materialize(&state_from, &state_towards, path, 0.25, &exact,
+                              &trajectory) != 1) ||
+        (exact != 1) || trajectory.list_states.empty())
+      return 1;
+    smp::StateDubins &state_last = *trajectory.list_states.back();
+    if ((fabs(state_last[0] - state_towards[0]) > 1e-6) ||
+        (fabs(state_last[1] - state_towards[1]) > 1e-6) ||
+        (fabs(remainder(state_last[2] - state_towards[2], 2.0 * M_PI)) >
+         1e-6))
+      return 1;
+
+    // A maximum length of zero skips every path, so only the bound is left.
+    double length_max = 0.0;
+    double bound;
+    if ((extender.lengths_from(&state_from, 1, &state_towards[0],
+                               &state_towards[1], &state_towards[2],
+                               &length_max, &bound) != 1) ||
+        (bound > path.get_length() + 1e-9))
+      return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include <smp/extenders/dubins_double_integrator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+// Integrates the inputs of a trajectory from its initial state, and returns
+// the largest error of the integrated states, including the duration.
+static double integration_error(
+    smp::StateDubinsDoubleIntegrator *state_from_in,
+    smp::Trajectory<smp::StateDubinsDoubleIntegrator,
+                    smp::InputDubinsDoubleIntegrator> &trajectory,
+    double turning_radius, double duration) {
+
+  smp::StateDubinsDoubleIntegrator state = *state_from_in;
+  double error = 0.0;
+  double time = 0.0;
+
+  auto input_iter = trajectory.list_inputs.begin();
+  for (auto state_curr : trajectory.list_states) {
+    double dt = (**input_iter)[0];
+    double direction = -(**input_iter)[1];
+    double u = (**input_iter)[2];
+    ++input_iter;
+
+    if (direction == 0.0) {
+      state[0] += dt * cos(state[3]);
+      state[1] += dt * sin(state[3]);
+    } else {
+      double t_next = state[3] + direction * dt / turning_radius;
+      state[0] += direction * turning_radius * (sin(t_next) - sin(state[3]));
+      state[1] -= direction * turning_radius * (cos(t_next) - cos(state[3]));
+      state[3] = t_next;
+    }
+    state[2] += state[4] * dt + u * dt * dt / 2.0;
+    state[4] += u * dt;
+    time += dt;
+
+    double heading = fabs(remainder(state[3] - (*state_curr)[3], 2.0 * M_PI));
+    error = std::max(error, heading);
+    for (int i : {0, 1, 2, 4})
+      error = std::max(error, fabs(state[i] - (*state_curr)[i]));
+  }
+
+  return std::max(error, fabs(time - duration));
+}
+
+// Extends the same random pairs of states with the Dubins double
+// integrator extender and with the plain Dubins extender, checks that the
+// trajectories of the former follow their inputs to the final states, and
+// times both.
+int main() {
+  const int num_pairs = 2000;
+
+  smp::extenders::DubinsDoubleIntegrator extender_ddi;
+  smp::extenders::Dubins extender_dubins;
+  extender_dubins.set_turning_radius(2.5);
+  extender_dubins.set_step(0.2);
+
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> heading(0.0, 2.0 * M_PI);
+  std::uniform_real_distribution<double> altitude(-0.5, 0.5);
+
+  std::vector<smp::StateDubinsDoubleIntegrator> states(2 * num_pairs);
+  std::vector<smp::StateDubins> states_dubins(2 * num_pairs);
+  for (int i = 0; i < 2 * num_pairs; i++) {
+    states[i][0] = states_dubins[i][0] = position(generator);
+    states[i][1] = states_dubins[i][1] = position(generator);
+    states[i][3] = states_dubins[i][2] = heading(generator);
+    states[i][2] = altitude(generator);
+  }
+
+  int failures = 0;
+  int exact;
+
+  auto time_beg = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_pairs; i++) {
+    smp::Trajectory<smp::StateDubinsDoubleIntegrator,
+                    smp::InputDubinsDoubleIntegrator>
+        trajectory;
+    std::list<smp::StateDubinsDoubleIntegrator *> intermediate_vertices;
+    if (extender_ddi.extend(&states[2 * i], &states[2 * i + 1], &exact,
+                            &trajectory, &intermediate_vertices) != 1)
+      failures++;
+  }
+  auto time_ddi = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_pairs; i++) {
+    smp::Trajectory<smp::StateDubins, smp::InputDubins> trajectory;
+    std::list<smp::StateDubins *> intermediate_vertices;
+    extender_dubins.extend(&states_dubins[2 * i], &states_dubins[2 * i + 1],
+                           &exact, &trajectory, &intermediate_vertices);
+  }
+  auto time_dubins = std::chrono::steady_clock::now();
+
+  printf("dubins double integrator: %.2f us/extend, %d failures\n",
+         std::chrono::duration<double, std::micro>(time_ddi - time_beg)
+                 .count() /
+             num_pairs,
+         failures);
+  printf("dubins: %.2f us/extend\n",
+         std::chrono::duration<double, std::micro>(time_dubins - time_ddi)
+                 .count() /
+             num_pairs);
+
+  // The altitude changes are small enough for every pair to connect, and
+  // every trajectory must follow its inputs to the final state.
+  for (int i = 0; i < num_pairs; i++) {
+    smp::Trajectory<smp::StateDubinsDoubleIntegrator,
+                    smp::InputDubinsDoubleIntegrator>
+        trajectory;
+    if (extender_ddi.extend(&states[2 * i], &states[2 * i + 1], NULL,
+                            &trajectory, NULL) != 1)
+      continue;
+    double duration =
+        extender_ddi.extend_time(&states[2 * i], &states[2 * i + 1]);
+    double error =
+        integration_error(&states[2 * i], trajectory, 2.5, duration);
+    if (error > 1e-6) {
+      printf("pair %d: integration error %g\n", i, error);
+      failures++;
+    }
+  }
+
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#include <smp/extenders/dubins.hpp>
+#include <smp/extenders/reeds_shepp.hpp>
+
+#include <cmath>
+#include <cstdlib>
+
+static double random_in(double min, double max) {
+  return min + (max - min) * rand() / (double)RAND_MAX;
+}
+
+int main() {
+  smp::extenders::ReedsShepp extender;
+  smp::extenders::Dubins extender_dubins;
+
+  const int num_states = 32;
+  smp::StateReedsShepp states[num_states];
+  smp::StateReedsShepp *states_batch[num_states];
+  double x[num_states], y[num_states], t[num_states];
+
+  srand(1);
+  for (int k = 0; k < 100; k++) {
+    smp::StateReedsShepp state_from;
+    state_from[0] = random_in(-5.0, 5.0);
+    state_from[1] = random_in(-5.0, 5.0);
+    state_from[2] = random_in(-M_PI, M_PI);
+
+    for (int i = 0; i < num_states; i++) {
+      states[i][0] = random_in(-5.0, 5.0);
+      states[i][1] = random_in(-5.0, 5.0);
+      states[i][2] = random_in(-M_PI, M_PI);
+      states_batch[i] = &states[i];
+      x[i] = states[i][0];
+      y[i] = states[i][1];
+      t[i] = states[i][2];
+    }
+
+    double lengths[num_states], bounds_from[num_states], bounds_to[num_states];
+    if ((extender.lengths_from(&state_from, num_states, x, y, t, NULL,
+                               lengths) != 1) ||
+        (extender.cost_extend_lower_bounds_from(&state_from, states_batch,
+                                                num_states, NULL,
+                                                bounds_from) != 1) ||
+        (extender.cost_extend_lower_bounds_to(states_batch, &state_from,
+                                              num_states, NULL,
+                                              bounds_to) != 1))
+      return 1;
+
+    for (int i = 0; i < num_states; i++) {
+      smp::StateReedsShepp &state_towards = states[i];
+
+      smp::PathReedsShepp path, path_back;
+      if ((extender.solve(&state_from, &state_towards, &path) != 1) ||
+          (extender.solve(&state_towards, &state_from, &path_back) != 1))
+        return 1;
+      double length = path.get_length();
+
+      // The length is symmetric, and the batches give the same lengths.
+      if ((fabs(path_back.get_length() - length) > 1e-9) ||
+          (fabs(lengths[i] - length) > 1e-9) ||
+          (fabs(bounds_from[i] - length) > 1e-9) ||
+          (fabs(bounds_to[i] - length) > 1e-9))
+        return 1;
+
+      // Driving backwards can only shorten the Dubins path, and no path is
+      // shorter than the straight line.
+      smp::StateDubins state_from_dubins, state_towards_dubins;
+      for (int j = 0; j < 3; j++) {
+        state_from_dubins[j] = state_from[j];
+        state_towards_dubins[j] = state_towards[j];
+      }
+      double length_dubins = extender_dubins.cost_extend_lower_bound(
+          &state_from_dubins, &state_towards_dubins);
+      if ((length > length_dubins + 1e-9) ||
+          (length <
+           extender.cost_lower_bound(&state_from, &state_towards) - 1e-9))
+        return 1;
+
+      // The last state of the path is the goal.
+      int exact = -1;
+      smp::Trajectory<smp::StateReedsShepp, smp::InputReedsShepp> trajectory;
+      if ((extender.materialize(&state_from, &state_towards, path, 0.25,
+                                &exact, &trajectory) != 1) ||
+          (exact != 1) || trajectory.list_states.empty())
+        return 1;
+      smp::StateReedsShepp &state_last = *trajectory.list_states.back();
+      if ((fabs(state_last[0] - state_towards[0]) > 1e-6) ||
+          (fabs(state_last[1] - state_towards[1]) > 1e-6) ||
+          (fabs(remainder(state_last[2] - state_towards[2], 2.0 * M_PI)) >
+           1e-6))
+        return 1;
+    }
+
+    // The paths that are not shorter than the maximum lengths are replaced
+    // by them.
+    double lengths_max[num_states], lengths_capped[num_states];
+    for (int i = 0; i < num_states; i++)
+      lengths_max[i] = (i % 2) ? lengths[i] / 2.0 : lengths[i] + 1.0;
+    if (extender.lengths_from(&state_from, num_states, x, y, t, lengths_max,
+                              lengths_capped) != 1)
+      return 1;
+    for (int i = 0; i < num_states; i++) {
+      double length_expected = (i % 2) ? lengths_max[i] : lengths[i];
+      if (fabs(lengths_capped[i] - length_expected) > 1e-9)
+        return 1;
+    }
+  }
+
+  return 0;
+}
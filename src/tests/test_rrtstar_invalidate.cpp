@@ -0,0 +1,245 @@
+#include <functional>
+
+#include <smp/collision_checkers/standard.hpp>
+#include <smp/distance_evaluators/kdtree.hpp>
+#include <smp/extenders/dubins.hpp>
+#include <smp/multipurpose/minimum_time_reachability.hpp>
+#include <smp/planners/edge_index.hpp>
+#include <smp/planners/rrtstar.hpp>
+#include <smp/samplers/uniform.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <unordered_set>
+
+typedef smp::StateDubins State;
+typedef smp::InputDubins Input;
+
+typedef smp::Vertex<State, Input> vertex_t;
+typedef smp::Edge<State, Input> edge_t;
+typedef smp::Trajectory<State, Input> trajectory_t;
+
+typedef smp::samplers::Uniform<State, 3> sampler_t;
+typedef smp::distance_evaluators::KDTree<State, Input, 3> distance_evaluator_t;
+typedef smp::extenders::Dubins extender_t;
+typedef smp::collision_checkers::Standard<State, Input, 2> collision_checker_t;
+typedef smp::multipurpose::MinimumTimeReachability<State, Input, 3>
+    min_time_reachability_t;
+typedef smp::planners::RRTStar<State, Input> planner_t;
+typedef smp::planners::EdgeIndex<State, Input> edge_index_t;
+
+// Returns the cost of the trajectory with the default cost function of
+// MinimumTimeReachability, i.e., the sum of the durations of its inputs.
+double trajectory_cost(const trajectory_t &trajectory) {
+  double cost = 0.0;
+  for (Input *input : trajectory.list_inputs)
+    cost += (*input)[0];
+  return cost;
+}
+
+bool edge_collides(collision_checker_t &collision_checker, edge_t *edge) {
+  std::list<State *> list_states = edge->trajectory_edge->list_states;
+  list_states.push_front(edge->vertex_src->state);
+  list_states.push_back(edge->vertex_dst->state);
+  return collision_checker.check_collision(list_states) != 1;
+}
+
+// Grows a tree that reaches the goal, blocks its best trajectory, and
+// invalidates the edges that the edge index finds around the obstacle.
+int test_invalidate(bool repair) {
+
+  sampler_t sampler;
+  distance_evaluator_t distance_evaluator;
+  extender_t extender;
+  collision_checker_t collision_checker;
+  min_time_reachability_t min_time_reachability;
+
+  planner_t planner(sampler, distance_evaluator, extender, collision_checker,
+                    min_time_reachability, min_time_reachability);
+
+  planner.parameters.set_phase(2);
+  planner.parameters.set_gamma(10.0);
+  planner.parameters.set_dimension(3);
+  planner.parameters.set_max_radius(10.0);
+
+  smp::Region<3> region_operating;
+  region_operating.size[0] = 10.0;
+  region_operating.size[1] = 10.0;
+  region_operating.size[2] = 2.0 * M_PI;
+  sampler.set_support(region_operating);
+  sampler.set_seed(1);
+  distance_evaluator.set_list_vertices(&(planner.list_vertices));
+
+  smp::Region<3> region_goal;
+  region_goal.center[0] = 4.0;
+  region_goal.center[1] = 4.0;
+  region_goal.size[0] = 0.75;
+  region_goal.size[1] = 0.75;
+  region_goal.size[2] = 10.0;
+  min_time_reachability.set_goal_region(region_goal);
+
+  edge_index_t edge_index;
+  edge_index.set_grid(-5.0, -5.0, 10.0, 10.0, 0.5);
+  planner.register_new_update_function_edge_insert(std::bind(
+      &edge_index_t::update_insert_edge, &edge_index, std::placeholders::_1));
+  planner.register_new_update_function_edge_delete(std::bind(
+      &edge_index_t::update_delete_edge, &edge_index, std::placeholders::_1));
+
+  // Every best trajectory that the update functions get must lead back to
+  // the root, so its cost is the best cost.
+  int num_errors = 0;
+  min_time_reachability.register_new_update_function(
+      [&](trajectory_t *trajectory) {
+        double cost_best = min_time_reachability.get_best_cost();
+        if (trajectory->list_states.empty())
+          return 1;
+        if (std::fabs(trajectory_cost(*trajectory) - cost_best) >
+            1e-6 * (1.0 + cost_best)) {
+          std::cout << "ERROR: The best trajectory costs "
+                    << trajectory_cost(*trajectory) << " instead of "
+                    << cost_best << std::endl;
+          num_errors++;
+        }
+        return 1;
+      });
+
+  State *state_initial = new State;
+  (*state_initial)[0] = -4.0;
+  (*state_initial)[1] = -4.0;
+  (*state_initial)[2] = 0.0;
+  planner.initialize(state_initial);
+
+  for (int i = 0; (i < 20000) && (min_time_reachability.get_best_cost() < 0.0);
+       i++)
+    planner.iteration();
+  for (int i = 0; i < 2000; i++)
+    planner.iteration();
+
+  trajectory_t trajectory_best;
+  min_time_reachability.get_solution(trajectory_best);
+  if (trajectory_best.list_states.size() < 2) {
+    std::cout << "ERROR: No trajectory reaches the goal" << std::endl;
+    return 1;
+  }
+
+  // Block the middle of the best trajectory.
+  State *state_blocked = *std::next(trajectory_best.list_states.begin(),
+                                    trajectory_best.list_states.size() / 2);
+  smp::Region<2> obstacle;
+  obstacle.center[0] = (*state_blocked)[0];
+  obstacle.center[1] = (*state_blocked)[1];
+  obstacle.size[0] = 1.0;
+  obstacle.size[1] = 1.0;
+  collision_checker.add_obstacle(obstacle);
+
+  std::list<edge_t *> list_edges;
+  edge_index.find_edges(obstacle.center[0] - 0.5, obstacle.center[1] - 0.5,
+                        obstacle.center[0] + 0.5, obstacle.center[1] + 0.5,
+                        &list_edges);
+
+  // The orphaned subtrees are below the edges that now collide.
+  std::unordered_set<edge_t *> set_edges_deleted;
+  std::unordered_set<vertex_t *> set_orphans;
+  for (edge_t *edge : list_edges) {
+    if (!edge_collides(collision_checker, edge))
+      continue;
+    set_edges_deleted.insert(edge);
+    std::list<vertex_t *> stack(1, edge->vertex_dst);
+    while (!stack.empty()) {
+      vertex_t *vertex = stack.back();
+      stack.pop_back();
+      if (!set_orphans.insert(vertex).second)
+        continue;
+      for (edge_t *edge_out : vertex->outgoing_edges)
+        stack.push_back(edge_out->vertex_dst);
+    }
+  }
+  if (set_edges_deleted.empty()) {
+    std::cout << "ERROR: The obstacle blocks no edge" << std::endl;
+    return 1;
+  }
+
+  int num_deleted = planner.invalidate_edges(list_edges, repair);
+
+  // Without repair, every orphan is deleted. With repair, some of them are
+  // reconnected.
+  if (!repair && (num_deleted != (int)set_orphans.size())) {
+    std::cout << "ERROR: Deleted " << num_deleted << " vertices instead of "
+              << set_orphans.size() << std::endl;
+    num_errors++;
+  }
+  if (repair && ((num_deleted < 0) ||
+                 (num_deleted >= (int)set_orphans.size()))) {
+    std::cout << "ERROR: Reconnected none of the " << set_orphans.size()
+              << " orphans" << std::endl;
+    num_errors++;
+  }
+
+  // The remaining vertices lead back to the root, and the edges of the tree
+  // are free and are exactly the ones in the index.
+  vertex_t *vertex_root = planner.get_root_vertex();
+  std::unordered_set<edge_t *> set_edges;
+  for (vertex_t *vertex : planner.list_vertices) {
+    if ((vertex != vertex_root) && (vertex->incoming_edges.size() != 1)) {
+      std::cout << "ERROR: A vertex is not connected to the root" << std::endl;
+      num_errors++;
+    }
+    if (!std::isfinite(vertex->data.total_cost)) {
+      std::cout << "ERROR: A vertex has an infinite cost" << std::endl;
+      num_errors++;
+    }
+    for (edge_t *edge : vertex->outgoing_edges) {
+      set_edges.insert(edge);
+      if (edge_collides(collision_checker, edge)) {
+        std::cout << "ERROR: An edge collides" << std::endl;
+        num_errors++;
+      }
+    }
+  }
+
+  std::list<edge_t *> list_edges_indexed;
+  edge_index.find_edges(-5.0, -5.0, 5.0, 5.0, &list_edges_indexed);
+  if ((edge_index.get_num_edges() != (int)set_edges.size()) ||
+      (list_edges_indexed.size() != set_edges.size())) {
+    std::cout << "ERROR: The index has " << edge_index.get_num_edges()
+              << " edges instead of " << set_edges.size() << std::endl;
+    num_errors++;
+  }
+  for (edge_t *edge : list_edges_indexed) {
+    if (set_edges.find(edge) == set_edges.end()) {
+      std::cout << "ERROR: The index has a deleted edge" << std::endl;
+      num_errors++;
+      break;
+    }
+  }
+
+  // The best cost is the cost of a trajectory from the root, if any is left.
+  double cost_best = min_time_reachability.get_best_cost();
+  trajectory_best.clear_delete();
+  min_time_reachability.get_solution(trajectory_best);
+  if ((cost_best >= 0.0) &&
+      (std::fabs(trajectory_cost(trajectory_best) - cost_best) >
+       1e-6 * (1.0 + cost_best))) {
+    std::cout << "ERROR: The best trajectory costs "
+              << trajectory_cost(trajectory_best) << " instead of "
+              << cost_best << std::endl;
+    num_errors++;
+  }
+
+  double cost_best_tree = -1.0;
+  for (vertex_t *vertex : planner.list_vertices) {
+    if (min_time_reachability.reaches_goal(vertex) &&
+        ((cost_best_tree < 0.0) || (vertex->data.total_cost < cost_best_tree)))
+      cost_best_tree = vertex->data.total_cost;
+  }
+  if (cost_best != cost_best_tree) {
+    std::cout << "ERROR: The best cost is " << cost_best << " instead of "
+              << cost_best_tree << std::endl;
+    num_errors++;
+  }
+
+  return (num_errors > 0) ? 1 : 0;
+}
+
+int main() { return test_invalidate(true) + test_invalidate(false); }
@@ -0,0 +1,232 @@
+#include <smp/samplers/adaptive.hpp>
+#include <smp/samplers/trajectory_bias.hpp>
+#include <smp/samplers/uniform.hpp>
+#include <smp/samplers/wavefront.hpp>
+
+#include <smp/extenders/dubins.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+// Samples around a trajectory whose heading crosses pi. The headings of the
+// samples must stay near pi, within [-pi, pi].
+static int test_trajectory_bias_heading() {
+  smp::samplers::TrajectoryBias<smp::StateDubins, smp::InputDubins, 3>
+      sampler;
+
+  smp::Region<3> support;
+  for (int i = 0; i < 2; i++) {
+    support.center[i] = 0.0;
+    support.size[i] = 10.0;
+  }
+  support.center[2] = 0.0;
+  support.size[2] = 2 * M_PI;
+  sampler.set_support(support);
+  sampler.set_bias_probability(1.0);
+  sampler.set_sample_dispersion(0.1);
+  sampler.set_angular_dispersion(2, 0.1);
+
+  smp::StateDubins state_beg, state_end;
+  state_beg[0] = 0.0;
+  state_beg[1] = 0.0;
+  state_beg[2] = 3.0;
+  state_end[0] = 1.0;
+  state_end[1] = 0.0;
+  state_end[2] = -3.0;
+  smp::Trajectory<smp::StateDubins, smp::InputDubins> trajectory;
+  trajectory.list_states.push_back(&state_beg);
+  trajectory.list_states.push_back(&state_end);
+  sampler.update_trajectory(&trajectory);
+  trajectory.list_states.clear();
+
+  for (int i = 0; i < 1000; i++) {
+    smp::StateDubins state;
+    if (sampler.sample_into(&state) <= 0)
+      return 1;
+    if ((fabs(state[2]) < 3.0 - 0.05) || (fabs(state[2]) > M_PI))
+      return 1;
+  }
+
+  return 0;
+}
+
+// Uniform sampler that counts the reports it receives.
+struct CountingSampler : smp::samplers::Uniform<smp::StateDubins, 3> {
+  int num_updates = 0;
+  int update(smp::StateDubins * /*state_in*/, double /*reward*/) {
+    num_updates++;
+    return 1;
+  }
+};
+
+// Reports every sample of a trajectory bias sampler that draws its unbiased
+// samples through an adaptive sampler. Only the reports of the unbiased
+// samples may reach the adaptive sampler and the sampler behind it.
+static int test_adaptive_credit() {
+  CountingSampler sampler_counting;
+  smp::samplers::Adaptive<smp::StateDubins, 3> sampler_adaptive(
+      sampler_counting);
+  smp::samplers::TrajectoryBias<smp::StateDubins, smp::InputDubins, 3>
+      sampler_trajectory_bias(sampler_adaptive);
+  sampler_trajectory_bias.set_bias_probability(0.5);
+
+  smp::StateDubins state_beg, state_end;
+  state_end[0] = 0.1;
+  smp::Trajectory<smp::StateDubins, smp::InputDubins> trajectory;
+  trajectory.list_states.push_back(&state_beg);
+  trajectory.list_states.push_back(&state_end);
+  sampler_trajectory_bias.update_trajectory(&trajectory);
+  trajectory.list_states.clear();
+
+  int num_sampled = 0;
+  for (int i = 0; i < 1000; i++) {
+    smp::StateDubins state;
+    unsigned long num_samples = sampler_adaptive.get_num_samples();
+    if (sampler_trajectory_bias.sample_into(&state) <= 0)
+      return 1;
+    num_sampled += (sampler_adaptive.get_num_samples() != num_samples);
+    sampler_trajectory_bias.update(&state, 0.0);
+  }
+  if ((num_sampled == 0) || (num_sampled == 1000) ||
+      (sampler_counting.num_updates != num_sampled))
+    return 1;
+
+  // A report that does not follow a sample of the adaptive sampler is
+  // ignored.
+  smp::StateDubins state;
+  sampler_adaptive.update(&state, 1.0);
+  return (sampler_counting.num_updates == num_sampled) ? 0 : 1;
+}
+
+// Obstacle of a grid map, in cells, [x_min, x_max) x [y_min, y_max).
+struct BoxCells {
+  int x_min, y_min, x_max, y_max;
+};
+
+// Whether the segment passes through the interior of the box.
+static bool segment_crosses(double x0, double y0, double x1, double y1,
+                            const double *box) {
+  double t_min = 0.0, t_max = 1.0;
+  double p[2] = {x0, y0}, d[2] = {x1 - x0, y1 - y0};
+  for (int i = 0; i < 2; i++) {
+    double lower = box[i], upper = box[i + 2];
+    if (d[i] == 0.0) {
+      if ((p[i] <= lower) || (p[i] >= upper))
+        return false;
+      continue;
+    }
+    double t_0 = (lower - p[i]) / d[i], t_1 = (upper - p[i]) / d[i];
+    t_min = std::max(t_min, std::min(t_0, t_1));
+    t_max = std::min(t_max, std::max(t_0, t_1));
+  }
+  // The segment may only touch the boundary of the box.
+  return t_max - t_min > 1e-9;
+}
+
+// Compares the wavefront lower bound with the length of the shortest path
+// through the free cells, which goes through the corners of the obstacles.
+static int test_wavefront_lower_bound() {
+  const int size = 40;
+  const double resolution = 0.1;
+  const BoxCells obstacles_cells[3] = {
+      {5, 5, 15, 35}, {20, 10, 35, 13}, {25, 20, 28, 40}};
+
+  std::vector<unsigned char> free_mask(size * size, 1);
+  std::vector<double> boxes;   // x_min, y_min, x_max, y_max in meters
+  std::vector<double> corners; // x, y in meters
+  for (const BoxCells &obstacle : obstacles_cells) {
+    for (int y = obstacle.y_min; y < obstacle.y_max; y++)
+      for (int x = obstacle.x_min; x < obstacle.x_max; x++)
+        free_mask[y * size + x] = 0;
+    double box[4] = {obstacle.x_min * resolution, obstacle.y_min * resolution,
+                     obstacle.x_max * resolution, obstacle.y_max * resolution};
+    boxes.insert(boxes.end(), box, box + 4);
+    for (int i = 0; i < 4; i++) {
+      corners.push_back(box[(i & 1) ? 2 : 0]);
+      corners.push_back(box[(i & 2) ? 3 : 1]);
+    }
+  }
+
+  const double x_goal = 3.55, y_goal = 0.55;
+  smp::samplers::Wavefront wavefront;
+  if (wavefront.compute(free_mask.data(), size, size, resolution, 0.0, 0.0,
+                        x_goal, y_goal, x_goal, y_goal) <= 0)
+    return 1;
+
+  srand(1);
+  int num_compared = 0;
+  for (int i = 0; i < 200; i++) {
+    double x = size * resolution * rand() / (double)RAND_MAX;
+    double y = size * resolution * rand() / (double)RAND_MAX;
+    int cell_x = std::min((int)(x / resolution), size - 1);
+    int cell_y = std::min((int)(y / resolution), size - 1);
+    if (!free_mask[cell_y * size + cell_x])
+      continue;
+
+    // Dijkstra on the visibility graph of the position, the corners, and the
+    // goal, which are the last two nodes.
+    std::vector<double> nodes = corners;
+    nodes.push_back(x);
+    nodes.push_back(y);
+    nodes.push_back(x_goal);
+    nodes.push_back(y_goal);
+    int num_nodes = (int)nodes.size() / 2;
+    std::vector<double> lengths(num_nodes,
+                                std::numeric_limits<double>::infinity());
+    std::vector<bool> done(num_nodes, false);
+    lengths[num_nodes - 2] = 0.0;
+    while (true) {
+      int node = -1;
+      for (int j = 0; j < num_nodes; j++)
+        if (!done[j] && ((node < 0) || (lengths[j] < lengths[node])))
+          node = j;
+      if ((node < 0) || std::isinf(lengths[node]))
+        break;
+      done[node] = true;
+      for (int j = 0; j < num_nodes; j++) {
+        bool visible = true;
+        for (size_t k = 0; visible && (k < boxes.size()); k += 4)
+          visible = !segment_crosses(nodes[2 * node], nodes[2 * node + 1],
+                                     nodes[2 * j], nodes[2 * j + 1],
+                                     &boxes[k]);
+        if (visible)
+          lengths[j] = std::min(
+              lengths[j],
+              lengths[node] + hypot(nodes[2 * j] - nodes[2 * node],
+                                    nodes[2 * j + 1] - nodes[2 * node + 1]));
+      }
+    }
+
+    double length_shortest = lengths[num_nodes - 1];
+    if (wavefront.get_lower_bound(x, y) > length_shortest)
+      return 1;
+    num_compared++;
+  }
+
+  return (num_compared > 100) ? 0 : 1;
+}
+
+int main() {
+  smp::samplers::Uniform<smp::StateDubins, 3> sampler_uniform;
+  smp::samplers::Adaptive<smp::StateDubins, 3> sampler_adaptive(
+      sampler_uniform);
+  smp::samplers::TrajectoryBias<smp::StateDubins, smp::InputDubins, 3>
+      sampler_trajectory_bias(sampler_adaptive);
+
+  smp::StateDubins state;
+  if (sampler_trajectory_bias.sample_into(&state) <= 0)
+    return 1;
+  if (sampler_trajectory_bias.update(&state, 0.0) <= 0)
+    return 1;
+
+  if (test_trajectory_bias_heading() != 0)
+    return 1;
+
+  if (test_wavefront_lower_bound() != 0)
+    return 1;
+
+  return test_adaptive_credit();
+}
@@ -0,0 +1,26 @@
+#include <smp/extenders/single_integrator.hpp>
+
+#include <cmath>
+
+int main() {
+  smp::extenders::SingleIntegrator<3> extender;
+  if (extender.set_max_length(0.5) != 1)
+    return 1;
+
+  smp::StateSingleIntegrator<3> state_from, state_towards;
+  state_towards[0] = 1.0;
+
+  // The trajectory is truncated at the maximum length. The outputs other
+  // than the trajectory may be NULL.
+  smp::Trajectory<smp::StateSingleIntegrator<3>, smp::InputSingleIntegrator>
+      trajectory;
+  if (extender.extend(&state_from, &state_towards, NULL, &trajectory, NULL) !=
+      1)
+    return 1;
+  if ((trajectory.list_states.size() != 1) ||
+      (fabs((*trajectory.list_states.back())[0] - 0.5) > 1e-12))
+    return 1;
+
+  return (extender.cost_lower_bound(&state_from, &state_towards) == 1.0) ? 0
+                                                                         : 1;
+}